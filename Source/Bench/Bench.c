@@ -0,0 +1,154 @@
+// Microbenchmarks for the server hot paths, see `spadesx-bench --help`
+#include <Bench/Bench.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef BENCH_DEFAULT_MAP
+    #define BENCH_DEFAULT_MAP "Resources/maps/Border_Hallway/Border_Hallway.vxl"
+#endif
+
+static const bench_options_t* g_options = NULL;
+
+#ifdef __GLIBC__
+// Count every heap allocation by wrapping the glibc allocator entry points.
+// Only the count is kept, frees are not interesting for allocs/op.
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t num, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+
+static uint64_t g_alloc_count = 0;
+
+void* malloc(size_t size)
+{
+    g_alloc_count++;
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t num, size_t size)
+{
+    g_alloc_count++;
+    return __libc_calloc(num, size);
+}
+
+void* realloc(void* ptr, size_t size)
+{
+    g_alloc_count++;
+    return __libc_realloc(ptr, size);
+}
+
+uint64_t bench_alloc_count(void)
+{
+    return g_alloc_count;
+}
+
+int bench_alloc_tracking(void)
+{
+    return 1;
+}
+#else
+uint64_t bench_alloc_count(void)
+{
+    return 0;
+}
+
+int bench_alloc_tracking(void)
+{
+    return 0;
+}
+#endif
+
+static inline uint64_t _bench_nanos(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+void bench_run(const char* name, uint64_t iterations, bench_fn_t op, bench_fn_t prepare, void* arg)
+{
+    if (g_options->filter != NULL && strstr(name, g_options->filter) == NULL) {
+        return;
+    }
+
+    iterations = (uint64_t) (iterations * g_options->scale);
+    if (iterations == 0) {
+        iterations = 1;
+    }
+
+    // One untimed warm up run so lazily initialised state does not end up in the numbers
+    if (prepare != NULL) {
+        prepare(arg);
+    }
+    op(arg);
+
+    uint64_t elapsed = 0;
+    uint64_t allocs  = 0;
+    if (prepare == NULL) {
+        uint64_t allocs_start = bench_alloc_count();
+        uint64_t start        = _bench_nanos();
+        for (uint64_t i = 0; i < iterations; ++i) {
+            op(arg);
+        }
+        elapsed = _bench_nanos() - start;
+        allocs  = bench_alloc_count() - allocs_start;
+    } else {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            prepare(arg);
+            uint64_t allocs_start = bench_alloc_count();
+            uint64_t start        = _bench_nanos();
+            op(arg);
+            elapsed += _bench_nanos() - start;
+            allocs += bench_alloc_count() - allocs_start;
+        }
+    }
+
+    double ns_per_op = (double) elapsed / (double) iterations;
+    if (bench_alloc_tracking()) {
+        printf("%-40s %10llu %16.1f ns/op %12.2f allocs/op\n",
+               name,
+               (unsigned long long) iterations,
+               ns_per_op,
+               (double) allocs / (double) iterations);
+    } else {
+        printf("%-40s %10llu %16.1f ns/op %12s allocs/op\n", name, (unsigned long long) iterations, ns_per_op, "-");
+    }
+    fflush(stdout);
+}
+
+static void _print_usage(const char* program)
+{
+    printf("Usage: %s [-m map.vxl] [-s scale] [filter]\n"
+           "  -m  VXL map to run the map and physics cases on (default: %s)\n"
+           "  -s  Multiply the iteration count of every case (default: 1.0)\n"
+           "  filter  Only run cases whose name contains this string\n",
+           program,
+           BENCH_DEFAULT_MAP);
+}
+
+int main(int argc, char** argv)
+{
+    bench_options_t options = {BENCH_DEFAULT_MAP, NULL, 1.0};
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+            options.map_path = argv[++i];
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            options.scale = atof(argv[++i]);
+            if (options.scale <= 0) {
+                options.scale = 1.0;
+            }
+        } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            _print_usage(argv[0]);
+            return EXIT_SUCCESS;
+        } else {
+            options.filter = argv[i];
+        }
+    }
+
+    g_options = &options;
+    printf("%-40s %10s %19s %22s\n", "case", "iterations", "time", "allocations");
+    bench_cases_run(&options);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,42 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+
+typedef void (*bench_fn_t)(void* arg);
+
+typedef struct bench_options
+{
+    const char* map_path;
+    const char* filter;
+    double      scale;
+} bench_options_t;
+
+/**
+ * @brief Number of heap allocations (malloc, calloc, realloc) done by the process so far
+ *
+ * @return Allocation count or 0 when allocation tracking is unavailable
+ */
+uint64_t bench_alloc_count(void);
+
+/**
+ * @brief Whether allocations are being counted (glibc only)
+ *
+ * @return 1 if tracked
+ */
+int bench_alloc_tracking(void);
+
+/**
+ * @brief Run one benchmark case and print its ns/op and allocs/op
+ *
+ * @param name Name of the case as printed in the report
+ * @param iterations Number of timed operations (scaled by --scale)
+ * @param op Operation to time
+ * @param prepare Optional untimed callback run before every operation
+ * @param arg Argument passed to both callbacks
+ */
+void bench_run(const char* name, uint64_t iterations, bench_fn_t op, bench_fn_t prepare, void* arg);
+
+void bench_cases_run(const bench_options_t* options);
+
+#endif /* BENCH_H */
@@ -0,0 +1,344 @@
+#include <Bench/Bench.h>
+#include <Server/Map.h>
+#include <Server/Nodes.h>
+#include <Server/Packets/Packets.h>
+#include <Server/Server.h>
+#include <Server/Structs/ServerStruct.h>
+#include <Util/Alloc.h>
+#include <Util/Compress.h>
+#include <Util/Enums.h>
+#include <Util/Line.h>
+#include <Util/MersenneTwister/MT.h>
+#include <Util/Physics.h>
+#include <Util/Queue.h>
+#include <Util/Uthash.h>
+#include <Util/Utlist.h>
+#include <enet/enet.h>
+#include <libmapvxl/libmapvxl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BENCH_SAMPLES       1024
+#define BENCH_WORLD_PLAYERS 32
+
+typedef struct bench_map
+{
+    server_t* server;
+    uint8_t*  vxl;
+    size_t    vxl_size;
+    uint8_t*  out;
+    size_t    out_size;
+} bench_map_t;
+
+typedef struct bench_rays
+{
+    server_t*  server;
+    vector3f_t from[BENCH_SAMPLES];
+    vector3f_t to[BENCH_SAMPLES];
+    vector3i_t line_from[BENCH_SAMPLES];
+    vector3i_t line_to[BENCH_SAMPLES];
+    uint32_t   index;
+} bench_rays_t;
+
+typedef struct bench_structure
+{
+    server_t*  server;
+    vector3i_t origin;
+    int        edge;
+} bench_structure_t;
+
+typedef struct bench_mover
+{
+    server_t*  server;
+    player_t*  player;
+    physics_t  physics;
+    vector3f_t spawn;
+    uint32_t   tick;
+} bench_mover_t;
+
+typedef struct bench_world
+{
+    server_t* server;
+    player_t* receiver;
+} bench_world_t;
+
+static vector3f_t _random_open_position(server_t* server, mt_rand_t* rand)
+{
+    mapvxl_t*  map = &server->s_map.map;
+    vector3f_t position;
+    position.x = 1 + gen_rand(rand) * (map->size_x - 2);
+    position.y = 1 + gen_rand(rand) * (map->size_y - 2);
+    int top    = mapvxl_find_top_block(map, (int) position.x, (int) position.y);
+    position.z = top - 1.5f - gen_rand(rand) * (top > 8 ? 8 : top);
+    return position;
+}
+
+static void _op_map_prepare_read(void* arg)
+{
+    bench_map_t* ctx = (bench_map_t*) arg;
+    mapvxl_t*    map = &ctx->server->s_map.map;
+    int          x = map->size_x, y = map->size_y, z = map->size_z;
+    mapvxl_free(map);
+    mapvxl_create(map, x, y, z);
+}
+
+static void _op_map_read(void* arg)
+{
+    bench_map_t* ctx = (bench_map_t*) arg;
+    mapvxl_read(&ctx->server->s_map.map, ctx->vxl);
+}
+
+static void _op_map_write(void* arg)
+{
+    bench_map_t* ctx = (bench_map_t*) arg;
+    ctx->out_size    = mapvxl_write(&ctx->server->s_map.map, ctx->out);
+}
+
+static void _op_compress_queue(void* arg)
+{
+    bench_map_t* ctx   = (bench_map_t*) arg;
+    queue_t*     queue = compress_queue(ctx->server, ctx->out, ctx->out_size, DEFAULT_COMPRESS_CHUNK_SIZE);
+    queue_t *    node, *tmp;
+    DL_FOREACH_SAFE(queue, node, tmp)
+    {
+        DL_DELETE(queue, node);
+        free(node->block);
+        free(node);
+    }
+}
+
+static void _op_line_get_blocks(void* arg)
+{
+    bench_rays_t* ctx = (bench_rays_t*) arg;
+    vector3i_t    result[LINE_MAX_LENGTH];
+    vector3i_t    size = {
+    ctx->server->s_map.map.size_x, ctx->server->s_map.map.size_y, ctx->server->s_map.map.size_z};
+    uint32_t i = ctx->index++ & (BENCH_SAMPLES - 1);
+    line_get_blocks(&ctx->line_from[i], &ctx->line_to[i], size, result);
+}
+
+static void _op_cast_ray(void* arg)
+{
+    bench_rays_t* ctx = (bench_rays_t*) arg;
+    uint32_t      i   = ctx->index++ & (BENCH_SAMPLES - 1);
+    vector3f_t    from = ctx->from[i], to = ctx->to[i];
+    float         dx = to.x - from.x, dy = to.y - from.y, dz = to.z - from.z;
+    float         length = sqrtf(dx * dx + dy * dy + dz * dz);
+    long          x, y, z;
+    if (length > 0) {
+        physics_cast_ray(
+        ctx->server, from.x, from.y, from.z, dx / length, dy / length, dz / length, length, &x, &y, &z);
+    }
+}
+
+static void _op_can_see(void* arg)
+{
+    bench_rays_t* ctx = (bench_rays_t*) arg;
+    uint32_t      i   = ctx->index++ & (BENCH_SAMPLES - 1);
+    physics_can_see(
+    ctx->server, ctx->from[i].x, ctx->from[i].y, ctx->from[i].z, ctx->to[i].x, ctx->to[i].y, ctx->to[i].z);
+}
+
+static void _op_move_player(void* arg)
+{
+    bench_mover_t* ctx    = (bench_mover_t*) arg;
+    player_t*      player = ctx->player;
+    uint32_t       tick   = ctx->tick++;
+
+    // Walk around in a slowly turning circle and jump every now and then, respawning every 10 seconds
+    if ((tick % 600) == 0) {
+        player->movement.position = ctx->spawn;
+        player->movement.velocity = (vector3f_t) {0, 0, 0};
+    }
+    if ((tick % 16) == 0) {
+        float      angle       = (float) tick * 0.01f;
+        vector3f_t orientation = {cosf(angle), sinf(angle), 0.0f};
+        physics_reorient_player(player, &orientation);
+    }
+    player->move_forward = (tick % 240) < 200;
+    player->move_left    = (tick % 120) < 30;
+    player->sprinting    = (tick % 300) < 100;
+    player->jumping      = (tick % 90) == 0 && !player->airborne;
+
+    ctx->physics.ftotclk += ctx->physics.fsynctics;
+    physics_move_player(ctx->server, player, &ctx->physics);
+}
+
+static void _op_structure_prepare(void* arg)
+{
+    bench_structure_t* ctx = (bench_structure_t*) arg;
+    mapvxl_t*          map = &ctx->server->s_map.map;
+    for (int x = ctx->origin.x; x < ctx->origin.x + ctx->edge; ++x) {
+        for (int y = ctx->origin.y; y < ctx->origin.y + ctx->edge; ++y) {
+            for (int z = ctx->origin.z; z < ctx->origin.z + ctx->edge; ++z) {
+                mapvxl_set_color(map, x, y, z, 0xFF7F7F7F);
+            }
+        }
+    }
+}
+
+static void _op_check_node(void* arg)
+{
+    bench_structure_t* ctx = (bench_structure_t*) arg;
+    check_node(ctx->server, MAP_EDITOR_SERVER, ctx->origin);
+}
+
+static void _op_world_update(void* arg)
+{
+    bench_world_t* ctx = (bench_world_t*) arg;
+    send_world_update(ctx->server, ctx->receiver);
+}
+
+static void _bench_map(server_t* server, const char* path)
+{
+    bench_map_t ctx = {server, NULL, 0, NULL, 0};
+
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return;
+    }
+    fseek(file, 0L, SEEK_END);
+    ctx.vxl_size = ftell(file);
+    fseek(file, 0L, SEEK_SET);
+    ctx.vxl = (uint8_t*) spadesx_malloc(ctx.vxl_size);
+    if (fread(ctx.vxl, 1, ctx.vxl_size, file) != ctx.vxl_size) {
+        fclose(file);
+        free(ctx.vxl);
+        return;
+    }
+    fclose(file);
+
+    mapvxl_t* map = &server->s_map.map;
+    ctx.out       = (uint8_t*) spadesx_malloc(map->size_x * map->size_y * (map->size_z / 2) * 8);
+
+    bench_run("mapvxl_read", 20, _op_map_read, _op_map_prepare_read, &ctx);
+    bench_run("mapvxl_write", 20, _op_map_write, NULL, &ctx);
+    _op_map_write(&ctx);
+    bench_run("compress_queue", 10, _op_compress_queue, NULL, &ctx);
+
+    free(ctx.out);
+    free(ctx.vxl);
+}
+
+static void _bench_rays(server_t* server)
+{
+    bench_rays_t* ctx = (bench_rays_t*) spadesx_calloc(1, sizeof(*ctx));
+    mt_rand_t     rand = seed_rand(1337);
+    ctx->server        = server;
+    for (int i = 0; i < BENCH_SAMPLES; ++i) {
+        ctx->from[i] = _random_open_position(server, &rand);
+        // Targets within typical engagement range of the shooter
+        ctx->to[i].x = ctx->from[i].x + (gen_rand(&rand) - 0.5f) * 128.0f;
+        ctx->to[i].y = ctx->from[i].y + (gen_rand(&rand) - 0.5f) * 128.0f;
+        ctx->to[i].z = ctx->from[i].z + (gen_rand(&rand) - 0.5f) * 16.0f;
+        // Block lines are at most a few dozen blocks long
+        ctx->line_from[i] = (vector3i_t) {(int) ctx->from[i].x, (int) ctx->from[i].y, (int) ctx->from[i].z};
+        ctx->line_to[i]   = (vector3i_t) {ctx->line_from[i].x + (int) (gen_rand_long(&rand) % 33) - 16,
+                                        ctx->line_from[i].y + (int) (gen_rand_long(&rand) % 33) - 16,
+                                        ctx->line_from[i].z + (int) (gen_rand_long(&rand) % 17) - 8};
+    }
+
+    bench_run("line_get_blocks", 1000000, _op_line_get_blocks, NULL, ctx);
+    bench_run("physics_cast_ray", 1000000, _op_cast_ray, NULL, ctx);
+    bench_run("physics_can_see", 1000000, _op_can_see, NULL, ctx);
+    free(ctx);
+}
+
+static void _bench_move_player(server_t* server)
+{
+    bench_mover_t ctx = {0};
+    mapvxl_t*     map = &server->s_map.map;
+    ctx.server        = server;
+    ctx.player        = (player_t*) spadesx_calloc(1, sizeof(player_t));
+    ctx.physics       = (physics_t) {0.0f, 1.0f / 60.0f};
+    ctx.spawn.x       = map->size_x / 2 + 0.5f;
+    ctx.spawn.y       = map->size_y / 2 + 0.5f;
+    ctx.spawn.z       = mapvxl_find_top_block(map, map->size_x / 2, map->size_y / 2) - 2.4f;
+    ctx.player->alive = 1;
+    ctx.player->item  = TOOL_GUN;
+
+    bench_run("physics_move_player", 1000000, _op_move_player, NULL, &ctx);
+    free(ctx.player);
+}
+
+static void _bench_check_node(server_t* server)
+{
+    static const int edges[] = {1, 4, 8, 16}; // 1, 64, 512 and 4096 floating blocks
+    mapvxl_t*        map     = &server->s_map.map;
+    char             name[64];
+
+    for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); ++i) {
+        bench_structure_t ctx = {server, {map->size_x / 4, map->size_y / 4, 1}, edges[i]};
+        // Clear the structure's surroundings so that it is guaranteed to be floating
+        for (int x = ctx.origin.x - 1; x <= ctx.origin.x + ctx.edge; ++x) {
+            for (int y = ctx.origin.y - 1; y <= ctx.origin.y + ctx.edge; ++y) {
+                for (int z = 0; z <= ctx.origin.z + ctx.edge; ++z) {
+                    mapvxl_set_air(map, x, y, z);
+                }
+            }
+        }
+        snprintf(name, sizeof(name), "check_node/floating_%d", ctx.edge * ctx.edge * ctx.edge);
+        bench_run(name, edges[i] < 16 ? 2000 : 200, _op_check_node, _op_structure_prepare, &ctx);
+    }
+
+    // A single block resting on the ground, the common case when breaking blocks
+    vector3i_t        ground = {map->size_x / 2, map->size_y / 2, 0};
+    bench_structure_t ctx    = {server, ground, 1};
+    ctx.origin.z             = mapvxl_find_top_block(map, ground.x, ground.y) - 1;
+    bench_run("check_node/grounded", 20000, _op_check_node, _op_structure_prepare, &ctx);
+}
+
+static void _bench_world_update(server_t* server)
+{
+    bench_world_t ctx = {server, NULL};
+    mt_rand_t     rand = seed_rand(42);
+
+    server->protocol.max_players = BENCH_WORLD_PLAYERS;
+    for (uint8_t id = 0; id < BENCH_WORLD_PLAYERS; ++id) {
+        player_t* player = (player_t*) spadesx_calloc(1, sizeof(player_t));
+        // A never connected peer makes enet_peer_send fail, so only serialization is measured
+        player->peer              = (ENetPeer*) spadesx_calloc(1, sizeof(ENetPeer));
+        player->id                = id;
+        player->state             = STATE_READY;
+        player->team              = id & 1;
+        player->movement.position = _random_open_position(server, &rand);
+        player->movement.forward_orientation = (vector3f_t) {1.0f, 0.0f, 0.0f};
+        HASH_ADD(hh, server->players, id, sizeof(uint8_t), player);
+        server->protocol.num_players++;
+        if (ctx.receiver == NULL) {
+            ctx.receiver = player;
+        }
+    }
+
+    bench_run("send_world_update", 200000, _op_world_update, NULL, &ctx);
+
+    player_t *player, *tmp;
+    HASH_ITER(hh, server->players, player, tmp)
+    {
+        HASH_DEL(server->players, player);
+        free(player->peer);
+        free(player);
+    }
+    server->protocol.num_players = 0;
+}
+
+void bench_cases_run(const bench_options_t* options)
+{
+    server_t* server     = get_server();
+    int       map_size[] = {512, 512, 64};
+
+    if (map_load(server, options->map_path, map_size) == 0) {
+        fprintf(stderr, "Failed to load map %s\n", options->map_path);
+        exit(EXIT_FAILURE);
+    }
+
+    _bench_map(server, options->map_path);
+    _bench_rays(server);
+    _bench_move_player(server);
+    _bench_world_update(server);
+    // Runs last as it carves space for its structures out of the map
+    _bench_check_node(server);
+
+    mapvxl_free(&server->s_map.map);
+}
@@ -0,0 +1,733 @@
+// Golden-output regression harness for the player and grenade physics kernels, see `spadesx-physics-golden --help`
+//
+// Traces are scripted input sequences (buttons, orientation, frame time) together with the state the scalar
+// reference kernels produced for every tick. Replaying a trace through Util/Physics.c tells whether an optimised
+// kernel is still bit-exact, or within a given tolerance, and how much faster it is than the reference. The
+// physics-golden build target records a golden file into the build tree and verifies against it.
+#include <Bench/ReferencePhysics.h>
+#include <Server/Map.h>
+#include <Server/Server.h>
+#include <Server/Structs/GrenadeStruct.h>
+#include <Server/Structs/ServerStruct.h>
+#include <Util/Alloc.h>
+#include <Util/Enums.h>
+#include <Util/MersenneTwister/MT.h>
+#include <Util/Physics.h>
+#include <libmapvxl/libmapvxl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define GOLDEN_MAGIC       0x47505853 // "SXPG"
+#define GOLDEN_VERSION     1
+#define GOLDEN_MAX_MAPS    16
+#define GOLDEN_PATH_LENGTH 256
+
+#define GOLDEN_FORWARD   (1 << 0)
+#define GOLDEN_BACKWARDS (1 << 1)
+#define GOLDEN_LEFT      (1 << 2)
+#define GOLDEN_RIGHT     (1 << 3)
+#define GOLDEN_JUMP      (1 << 4)
+#define GOLDEN_CROUCH    (1 << 5)
+#define GOLDEN_SNEAK     (1 << 6)
+#define GOLDEN_SPRINT    (1 << 7)
+
+typedef enum golden_kernel {
+    KERNEL_MOVE_PLAYER   = 0,
+    KERNEL_BOX_CLIP_MOVE = 1,
+    KERNEL_MOVE_GRENADE  = 2,
+    KERNEL_COUNT
+} golden_kernel_t;
+
+static const char* kernel_names[KERNEL_COUNT] = {"physics_move_player", "physics_box_clip_move", "physics_move_grenade"};
+
+typedef struct golden_input
+{
+    float   dt;
+    uint8_t buttons;
+    uint8_t secondary_fire;
+    // Orientation for player traces, velocity injected before the call for box clip traces
+    vector3f_t vector;
+} golden_input_t;
+
+typedef struct golden_state
+{
+    vector3f_t position;
+    vector3f_t eye_pos;
+    vector3f_t velocity;
+    float      lastclimb;
+    uint8_t    airborne;
+    uint8_t    wade;
+    int32_t    result;
+} golden_state_t;
+
+typedef struct golden_trace
+{
+    golden_kernel_t kernel;
+    uint32_t        steps;
+    golden_state_t  initial;
+    golden_input_t* inputs;
+    golden_state_t* states;
+} golden_trace_t;
+
+typedef struct golden_map
+{
+    char            path[GOLDEN_PATH_LENGTH];
+    uint32_t        trace_count;
+    golden_trace_t* traces;
+} golden_map_t;
+
+typedef struct golden_set
+{
+    uint32_t     map_count;
+    golden_map_t maps[GOLDEN_MAX_MAPS];
+} golden_set_t;
+
+typedef struct golden_kernels
+{
+    long (*move_player)(server_t* server, player_t* player, physics_t* physics);
+    void (*box_clip_move)(server_t* server, player_t* player, physics_t* physics);
+    int (*move_grenade)(server_t* server, grenade_t* grenade, physics_t* physics);
+} golden_kernels_t;
+
+static const golden_kernels_t reference_kernels = {ref_physics_move_player,
+                                                   ref_physics_box_clip_move,
+                                                   ref_physics_move_grenade};
+static const golden_kernels_t live_kernels      = {physics_move_player, physics_box_clip_move, physics_move_grenade};
+
+typedef struct golden_report
+{
+    uint64_t steps;
+    uint64_t lockstep_diverged;
+    uint64_t discrete_mismatches;
+    uint64_t freerun_diverged_traces;
+    double   lockstep_max_error;
+    double   freerun_max_error;
+    uint64_t reference_nanos;
+    uint64_t live_nanos;
+} golden_report_t;
+
+static inline uint64_t _nanos(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+/*
+ * Simulation
+ */
+
+static void _state_load_player(player_t* player, const golden_state_t* state)
+{
+    player->movement.position = state->position;
+    player->movement.eye_pos  = state->eye_pos;
+    player->movement.velocity = state->velocity;
+    player->lastclimb         = state->lastclimb;
+    player->airborne          = state->airborne;
+    player->wade              = state->wade;
+}
+
+static void _state_save_player(golden_state_t* state, const player_t* player, int32_t result)
+{
+    state->position  = player->movement.position;
+    state->eye_pos   = player->movement.eye_pos;
+    state->velocity  = player->movement.velocity;
+    state->lastclimb = player->lastclimb;
+    state->airborne  = player->airborne;
+    state->wade      = player->wade;
+    state->result    = result;
+}
+
+static void _apply_input(player_t* player, const golden_input_t* input, golden_kernel_t kernel)
+{
+    player->move_forward   = (input->buttons & GOLDEN_FORWARD) != 0;
+    player->move_backwards = (input->buttons & GOLDEN_BACKWARDS) != 0;
+    player->move_left      = (input->buttons & GOLDEN_LEFT) != 0;
+    player->move_right     = (input->buttons & GOLDEN_RIGHT) != 0;
+    player->jumping        = (input->buttons & GOLDEN_JUMP) != 0;
+    player->crouching      = (input->buttons & GOLDEN_CROUCH) != 0;
+    player->sneaking       = (input->buttons & GOLDEN_SNEAK) != 0;
+    player->sprinting      = (input->buttons & GOLDEN_SPRINT) != 0;
+    player->secondary_fire = input->secondary_fire;
+    player->item           = TOOL_GUN;
+    if (kernel == KERNEL_BOX_CLIP_MOVE) {
+        player->movement.velocity = input->vector;
+    } else {
+        vector3f_t orientation = input->vector;
+        physics_reorient_player(player, &orientation);
+    }
+}
+
+/**
+ * @brief Advance a trace by one tick starting from `from` and store the result in `to`
+ */
+static void _step(server_t*               server,
+                  const golden_kernels_t* kernels,
+                  const golden_trace_t*   trace,
+                  uint32_t                step,
+                  float                   ftotclk,
+                  player_t*               player,
+                  const golden_state_t*   from,
+                  golden_state_t*         to)
+{
+    const golden_input_t* input   = &trace->inputs[step];
+    physics_t             physics = {ftotclk, input->dt};
+
+    if (trace->kernel == KERNEL_MOVE_GRENADE) {
+        grenade_t grenade = {0};
+        grenade.position  = from->position;
+        grenade.velocity  = from->velocity;
+        int32_t result    = kernels->move_grenade(server, &grenade, &physics);
+        memset(to, 0, sizeof(*to));
+        to->position = grenade.position;
+        to->velocity = grenade.velocity;
+        to->result   = result;
+        return;
+    }
+
+    _state_load_player(player, from);
+    _apply_input(player, input, trace->kernel);
+    int32_t result = 0;
+    if (trace->kernel == KERNEL_MOVE_PLAYER) {
+        result = (int32_t) kernels->move_player(server, player, &physics);
+    } else {
+        kernels->box_clip_move(server, player, &physics);
+    }
+    _state_save_player(to, player, result);
+}
+
+static uint64_t _run_trace(server_t* server, const golden_kernels_t* kernels, golden_trace_t* trace, player_t* player)
+{
+    golden_state_t state   = trace->initial;
+    float          ftotclk = 0.0f;
+    uint64_t       start   = _nanos();
+    for (uint32_t i = 0; i < trace->steps; ++i) {
+        ftotclk += trace->inputs[i].dt;
+        _step(server, kernels, trace, i, ftotclk, player, &state, &trace->states[i]);
+        state = trace->states[i];
+    }
+    return _nanos() - start;
+}
+
+/*
+ * Trace generation
+ */
+
+static vector3f_t _random_spawn(server_t* server, mt_rand_t* rand)
+{
+    mapvxl_t*  map = &server->s_map.map;
+    vector3f_t position;
+    position.x = 1 + (float) gen_rand(rand) * (map->size_x - 2);
+    position.y = 1 + (float) gen_rand(rand) * (map->size_y - 2);
+    position.z = mapvxl_find_top_block(map, (int) position.x, (int) position.y) - 2.4f;
+    return position;
+}
+
+static void _generate_trace(server_t* server, mt_rand_t* rand, golden_trace_t* trace, golden_kernel_t kernel, uint32_t steps)
+{
+    trace->kernel = kernel;
+    trace->steps  = steps;
+    trace->inputs = (golden_input_t*) spadesx_calloc(steps, sizeof(golden_input_t));
+    trace->states = (golden_state_t*) spadesx_calloc(steps, sizeof(golden_state_t));
+    memset(&trace->initial, 0, sizeof(trace->initial));
+    trace->initial.position = _random_spawn(server, rand);
+    trace->initial.eye_pos  = trace->initial.position;
+    trace->initial.airborne = 1;
+    trace->initial.lastclimb = -1.0f;
+
+    if (kernel == KERNEL_MOVE_GRENADE) {
+        // Thrown from eye height in a random direction with up to twice the default throw speed
+        float yaw   = (float) gen_rand(rand) * 6.2831853f;
+        float pitch = ((float) gen_rand(rand) - 0.7f) * 1.5f;
+        float speed = (float) gen_rand(rand) * 2.0f;
+        trace->initial.position.z -= 1.0f;
+        trace->initial.velocity.x = cosf(yaw) * cosf(pitch) * speed;
+        trace->initial.velocity.y = sinf(yaw) * cosf(pitch) * speed;
+        trace->initial.velocity.z = sinf(pitch) * speed;
+    }
+
+    uint8_t buttons = 0;
+    float   yaw     = (float) gen_rand(rand) * 6.2831853f;
+    float   pitch   = 0.0f;
+    for (uint32_t i = 0; i < steps; ++i) {
+        golden_input_t* input = &trace->inputs[i];
+        // Frame times jitter around 60 TPS the same way the server loop does
+        input->dt = (1.0f / 60.0f) * (0.8f + 0.4f * (float) gen_rand(rand));
+        if ((gen_rand_long(rand) % 30) == 0) {
+            buttons = (uint8_t) gen_rand_long(rand) & ~(GOLDEN_JUMP);
+        }
+        input->buttons = buttons;
+        if ((gen_rand_long(rand) % 45) == 0) {
+            input->buttons |= GOLDEN_JUMP;
+        }
+        input->secondary_fire = (gen_rand_long(rand) % 8) == 0;
+
+        yaw += ((float) gen_rand(rand) - 0.5f) * 0.2f;
+        pitch += ((float) gen_rand(rand) - 0.5f) * 0.1f;
+        pitch = fmaxf(-1.5f, fminf(1.5f, pitch));
+        if (kernel == KERNEL_BOX_CLIP_MOVE) {
+            float speed      = (float) gen_rand(rand) * 0.5f;
+            input->vector.x = cosf(yaw) * speed;
+            input->vector.y = sinf(yaw) * speed;
+            input->vector.z = ((float) gen_rand(rand) - 0.3f) * 0.5f;
+        } else {
+            input->vector.x = cosf(yaw) * cosf(pitch);
+            input->vector.y = sinf(yaw) * cosf(pitch);
+            input->vector.z = sinf(pitch);
+        }
+    }
+}
+
+static int _load_map(server_t* server, const char* path)
+{
+    int map_size[3] = {512, 512, 64};
+    map_free(server);
+    return map_load(server, path, map_size);
+}
+
+static void _generate_set(server_t* server, golden_set_t* set, uint32_t traces, uint32_t steps, unsigned long seed)
+{
+    for (uint32_t m = 0; m < set->map_count; ++m) {
+        golden_map_t* map  = &set->maps[m];
+        mt_rand_t     rand = seed_rand(seed + m);
+        if (_load_map(server, map->path) == 0) {
+            exit(EXIT_FAILURE);
+        }
+        map->trace_count = traces * KERNEL_COUNT;
+        map->traces      = (golden_trace_t*) spadesx_calloc(map->trace_count, sizeof(golden_trace_t));
+        player_t* player = (player_t*) spadesx_calloc(1, sizeof(player_t));
+        for (uint32_t t = 0; t < map->trace_count; ++t) {
+            _generate_trace(server, &rand, &map->traces[t], (golden_kernel_t) (t % KERNEL_COUNT), steps);
+            // The golden output always comes from the frozen scalar implementation
+            _run_trace(server, &reference_kernels, &map->traces[t], player);
+        }
+        free(player);
+    }
+}
+
+/*
+ * Serialization, all values little endian
+ */
+
+static void _write_u32(FILE* file, uint32_t value)
+{
+    uint8_t bytes[4] = {value & 0xFF, (value >> 8) & 0xFF, (value >> 16) & 0xFF, (value >> 24) & 0xFF};
+    fwrite(bytes, 1, 4, file);
+}
+
+static uint32_t _read_u32(FILE* file)
+{
+    uint8_t bytes[4] = {0};
+    if (fread(bytes, 1, 4, file) != 4) {
+        fprintf(stderr, "Golden file is truncated\n");
+        exit(EXIT_FAILURE);
+    }
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t) bytes[3] << 24);
+}
+
+static void _write_f32(FILE* file, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    _write_u32(file, bits);
+}
+
+static float _read_f32(FILE* file)
+{
+    uint32_t bits  = _read_u32(file);
+    float    value = 0;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static void _write_v3(FILE* file, vector3f_t v)
+{
+    _write_f32(file, v.x);
+    _write_f32(file, v.y);
+    _write_f32(file, v.z);
+}
+
+static vector3f_t _read_v3(FILE* file)
+{
+    vector3f_t v;
+    v.x = _read_f32(file);
+    v.y = _read_f32(file);
+    v.z = _read_f32(file);
+    return v;
+}
+
+static void _write_state(FILE* file, const golden_state_t* state)
+{
+    _write_v3(file, state->position);
+    _write_v3(file, state->eye_pos);
+    _write_v3(file, state->velocity);
+    _write_f32(file, state->lastclimb);
+    _write_u32(file, state->airborne | (state->wade << 8));
+    _write_u32(file, (uint32_t) state->result);
+}
+
+static void _read_state(FILE* file, golden_state_t* state)
+{
+    state->position  = _read_v3(file);
+    state->eye_pos   = _read_v3(file);
+    state->velocity  = _read_v3(file);
+    state->lastclimb = _read_f32(file);
+    uint32_t flags   = _read_u32(file);
+    state->airborne  = flags & 0xFF;
+    state->wade      = (flags >> 8) & 0xFF;
+    state->result    = (int32_t) _read_u32(file);
+}
+
+static int _save_set(const golden_set_t* set, const char* path)
+{
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Unable to open %s for writing\n", path);
+        return 0;
+    }
+    _write_u32(file, GOLDEN_MAGIC);
+    _write_u32(file, GOLDEN_VERSION);
+    _write_u32(file, set->map_count);
+    for (uint32_t m = 0; m < set->map_count; ++m) {
+        const golden_map_t* map = &set->maps[m];
+        fwrite(map->path, 1, GOLDEN_PATH_LENGTH, file);
+        _write_u32(file, map->trace_count);
+        for (uint32_t t = 0; t < map->trace_count; ++t) {
+            const golden_trace_t* trace = &map->traces[t];
+            _write_u32(file, trace->kernel);
+            _write_u32(file, trace->steps);
+            _write_state(file, &trace->initial);
+            for (uint32_t i = 0; i < trace->steps; ++i) {
+                _write_f32(file, trace->inputs[i].dt);
+                _write_u32(file, trace->inputs[i].buttons | (trace->inputs[i].secondary_fire << 8));
+                _write_v3(file, trace->inputs[i].vector);
+                _write_state(file, &trace->states[i]);
+            }
+        }
+    }
+    fclose(file);
+    return 1;
+}
+
+static int _load_set(golden_set_t* set, const char* path)
+{
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        fprintf(stderr,
+                "Unable to open %s, record it first with `record -o %s` or the physics-golden build target\n",
+                path,
+                path);
+        return 0;
+    }
+    if (_read_u32(file) != GOLDEN_MAGIC || _read_u32(file) != GOLDEN_VERSION) {
+        fprintf(stderr, "%s is not a golden file of version %d\n", path, GOLDEN_VERSION);
+        fclose(file);
+        return 0;
+    }
+    set->map_count = _read_u32(file);
+    if (set->map_count > GOLDEN_MAX_MAPS) {
+        fprintf(stderr, "%s has too many maps\n", path);
+        fclose(file);
+        return 0;
+    }
+    for (uint32_t m = 0; m < set->map_count; ++m) {
+        golden_map_t* map = &set->maps[m];
+        if (fread(map->path, 1, GOLDEN_PATH_LENGTH, file) != GOLDEN_PATH_LENGTH) {
+            fprintf(stderr, "Golden file is truncated\n");
+            exit(EXIT_FAILURE);
+        }
+        map->path[GOLDEN_PATH_LENGTH - 1] = '\0';
+        map->trace_count                  = _read_u32(file);
+        map->traces = (golden_trace_t*) spadesx_calloc(map->trace_count, sizeof(golden_trace_t));
+        for (uint32_t t = 0; t < map->trace_count; ++t) {
+            golden_trace_t* trace = &map->traces[t];
+            trace->kernel         = (golden_kernel_t) _read_u32(file);
+            trace->steps          = _read_u32(file);
+            if (trace->kernel >= KERNEL_COUNT) {
+                fprintf(stderr, "%s contains an unknown kernel\n", path);
+                exit(EXIT_FAILURE);
+            }
+            _read_state(file, &trace->initial);
+            trace->inputs = (golden_input_t*) spadesx_calloc(trace->steps, sizeof(golden_input_t));
+            trace->states = (golden_state_t*) spadesx_calloc(trace->steps, sizeof(golden_state_t));
+            for (uint32_t i = 0; i < trace->steps; ++i) {
+                trace->inputs[i].dt             = _read_f32(file);
+                uint32_t flags                  = _read_u32(file);
+                trace->inputs[i].buttons        = flags & 0xFF;
+                trace->inputs[i].secondary_fire = (flags >> 8) & 0xFF;
+                trace->inputs[i].vector         = _read_v3(file);
+                _read_state(file, &trace->states[i]);
+            }
+        }
+    }
+    fclose(file);
+    return 1;
+}
+
+static void _free_set(golden_set_t* set)
+{
+    for (uint32_t m = 0; m < set->map_count; ++m) {
+        for (uint32_t t = 0; t < set->maps[m].trace_count; ++t) {
+            free(set->maps[m].traces[t].inputs);
+            free(set->maps[m].traces[t].states);
+        }
+        free(set->maps[m].traces);
+    }
+}
+
+/*
+ * Verification
+ */
+
+static inline int _float_equal(float a, float b, float tolerance, double* error)
+{
+    double diff = fabs((double) a - (double) b);
+    if (diff > *error) {
+        *error = diff;
+    }
+    if (tolerance == 0.0f) {
+        return memcmp(&a, &b, sizeof(float)) == 0;
+    }
+    return diff <= tolerance;
+}
+
+static inline int _v3_equal(vector3f_t a, vector3f_t b, float tolerance, double* error)
+{
+    int x = _float_equal(a.x, b.x, tolerance, error);
+    int y = _float_equal(a.y, b.y, tolerance, error);
+    int z = _float_equal(a.z, b.z, tolerance, error);
+    return x && y && z;
+}
+
+/**
+ * @brief Compare continuous state with the tolerance and discrete state (flags, fall damage, bounces) exactly
+ *
+ * @return 0 if equal, 1 if the continuous state diverged, 2 if the discrete state diverged
+ */
+static int _state_compare(const golden_state_t* expected, const golden_state_t* actual, float tolerance, double* error)
+{
+    int equal = _v3_equal(expected->position, actual->position, tolerance, error);
+    equal &= _v3_equal(expected->eye_pos, actual->eye_pos, tolerance, error);
+    equal &= _v3_equal(expected->velocity, actual->velocity, tolerance, error);
+    equal &= _float_equal(expected->lastclimb, actual->lastclimb, tolerance, error);
+    if (expected->airborne != actual->airborne || expected->wade != actual->wade || expected->result != actual->result)
+    {
+        return 2;
+    }
+    return equal ? 0 : 1;
+}
+
+static void _verify_trace(server_t*             server,
+                          const golden_trace_t* trace,
+                          player_t*             player,
+                          float                 tolerance,
+                          golden_report_t*      report,
+                          int                   verbose)
+{
+    golden_state_t actual;
+    float          ftotclk = 0.0f;
+
+    // Lockstep: every tick starts from the golden state so only the error of a single step is measured
+    for (uint32_t i = 0; i < trace->steps; ++i) {
+        const golden_state_t* from = (i == 0) ? &trace->initial : &trace->states[i - 1];
+        ftotclk += trace->inputs[i].dt;
+        _step(server, &live_kernels, trace, i, ftotclk, player, from, &actual);
+        double error  = 0;
+        int    result = _state_compare(&trace->states[i], &actual, tolerance, &error);
+        if (error > report->lockstep_max_error) {
+            report->lockstep_max_error = error;
+        }
+        if (result != 0) {
+            report->lockstep_diverged++;
+            report->discrete_mismatches += (result == 2);
+            if (verbose) {
+                printf("  %s diverged at tick %u (error %g%s)\n",
+                       kernel_names[trace->kernel],
+                       i,
+                       error,
+                       result == 2 ? ", discrete state differs" : "");
+            }
+        }
+    }
+    report->steps += trace->steps;
+
+    // Free run: what a client would see if only the inputs were shared, errors are allowed to accumulate
+    golden_state_t state    = trace->initial;
+    double         worst    = 0;
+    int            diverged = 0;
+    ftotclk                 = 0.0f;
+    for (uint32_t i = 0; i < trace->steps; ++i) {
+        ftotclk += trace->inputs[i].dt;
+        _step(server, &live_kernels, trace, i, ftotclk, player, &state, &actual);
+        state = actual;
+        diverged |= _state_compare(&trace->states[i], &actual, tolerance, &worst) != 0;
+    }
+    if (worst > report->freerun_max_error) {
+        report->freerun_max_error = worst;
+    }
+    report->freerun_diverged_traces += diverged;
+}
+
+static void _time_kernels(server_t* server, golden_trace_t* trace, player_t* player, golden_report_t* report)
+{
+    // Both replays write into a scratch copy so the golden states stay untouched
+    golden_trace_t scratch = *trace;
+    scratch.states         = (golden_state_t*) spadesx_malloc(trace->steps * sizeof(golden_state_t));
+    report->reference_nanos += _run_trace(server, &reference_kernels, &scratch, player);
+    report->live_nanos += _run_trace(server, &live_kernels, &scratch, player);
+    free(scratch.states);
+}
+
+static int _verify_set(server_t* server, golden_set_t* set, float tolerance, uint32_t repeat, int verbose)
+{
+    golden_report_t reports[KERNEL_COUNT];
+    memset(reports, 0, sizeof(reports));
+    player_t* player = (player_t*) spadesx_calloc(1, sizeof(player_t));
+
+    for (uint32_t m = 0; m < set->map_count; ++m) {
+        golden_map_t* map = &set->maps[m];
+        if (_load_map(server, map->path) == 0) {
+            exit(EXIT_FAILURE);
+        }
+        if (verbose) {
+            printf("%s\n", map->path);
+        }
+        for (uint32_t t = 0; t < map->trace_count; ++t) {
+            golden_trace_t* trace = &map->traces[t];
+            _verify_trace(server, trace, player, tolerance, &reports[trace->kernel], verbose);
+            for (uint32_t r = 0; r < repeat; ++r) {
+                _time_kernels(server, trace, player, &reports[trace->kernel]);
+            }
+        }
+    }
+    free(player);
+
+    int failed = 0;
+    printf("%-24s %10s %10s %10s %12s %12s %12s %12s %9s\n",
+           "kernel",
+           "steps",
+           "diverged",
+           "discrete",
+           "step error",
+           "drift",
+           "ref ns/op",
+           "live ns/op",
+           "speed-up");
+    for (int k = 0; k < KERNEL_COUNT; ++k) {
+        golden_report_t* report = &reports[k];
+        if (report->steps == 0) {
+            continue;
+        }
+        double timed = (double) report->steps * (repeat ? repeat : 1);
+        double ref   = report->reference_nanos / timed;
+        double live  = report->live_nanos / timed;
+        printf("%-24s %10llu %10llu %10llu %12g %12g %12.1f %12.1f %8.2fx\n",
+               kernel_names[k],
+               (unsigned long long) report->steps,
+               (unsigned long long) report->lockstep_diverged,
+               (unsigned long long) report->discrete_mismatches,
+               report->lockstep_max_error,
+               report->freerun_max_error,
+               ref,
+               live,
+               live > 0 ? ref / live : 0.0);
+        failed |= report->lockstep_diverged != 0 || report->freerun_diverged_traces != 0;
+    }
+    printf("%s (%s)\n", failed ? "DIVERGED" : "OK", tolerance == 0.0f ? "bit-exact" : "tolerance-bounded");
+    return failed;
+}
+
+static void _print_usage(const char* program)
+{
+    printf("Usage: %s record  -o golden.bin [-m map.vxl]... [-n traces] [-l ticks] [--seed N]\n"
+           "       %s verify  -i golden.bin [-t tolerance] [-r repeat] [-v]\n"
+           "       %s compare [-m map.vxl]... [-n traces] [-l ticks] [-t tolerance] [-r repeat] [-v]\n"
+           "\n"
+           "record   Generate input traces and store the output of the reference scalar kernels\n"
+           "verify   Replay a golden file through Util/Physics.c and report divergence and speed-up\n"
+           "compare  Same as record followed by verify, without writing a file\n"
+           "\n"
+           "A tolerance of 0 (default) requires bit-exact results. Flags, fall damage and grenade bounce results\n"
+           "must always match exactly. Exits with 1 if anything diverged.\n",
+           program,
+           program,
+           program);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        _print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const char*   mode      = argv[1];
+    const char*   output    = NULL;
+    const char*   input     = NULL;
+    uint32_t      traces    = 32;
+    uint32_t      steps     = 1200;
+    uint32_t      repeat    = 3;
+    unsigned long seed      = 0x5ADE5;
+    float         tolerance = 0.0f;
+    int           verbose   = 0;
+    golden_set_t  set;
+    memset(&set, 0, sizeof(set));
+
+    for (int i = 2; i < argc; ++i) {
+        int has_value = i + 1 < argc;
+        if (strcmp(argv[i], "-m") == 0 && has_value && set.map_count < GOLDEN_MAX_MAPS) {
+            snprintf(set.maps[set.map_count++].path, GOLDEN_PATH_LENGTH, "%s", argv[++i]);
+        } else if (strcmp(argv[i], "-o") == 0 && has_value) {
+            output = argv[++i];
+        } else if (strcmp(argv[i], "-i") == 0 && has_value) {
+            input = argv[++i];
+        } else if (strcmp(argv[i], "-n") == 0 && has_value) {
+            traces = (uint32_t) strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-l") == 0 && has_value) {
+            steps = (uint32_t) strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-r") == 0 && has_value) {
+            repeat = (uint32_t) strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-t") == 0 && has_value) {
+            tolerance = (float) fabs(atof(argv[++i]));
+        } else if (strcmp(argv[i], "--seed") == 0 && has_value) {
+            seed = strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-v") == 0) {
+            verbose = 1;
+        } else {
+            _print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (set.map_count == 0) {
+        snprintf(set.maps[set.map_count++].path,
+                 GOLDEN_PATH_LENGTH,
+                 "%s",
+                 "Resources/maps/Border_Hallway/Border_Hallway.vxl");
+    }
+
+    server_t* server = get_server();
+    int       result = EXIT_SUCCESS;
+    if (strcmp(mode, "record") == 0 && output != NULL) {
+        _generate_set(server, &set, traces, steps, seed);
+        result = _save_set(&set, output) ? EXIT_SUCCESS : EXIT_FAILURE;
+    } else if (strcmp(mode, "verify") == 0 && input != NULL) {
+        memset(&set, 0, sizeof(set));
+        if (_load_set(&set, input) == 0) {
+            return EXIT_FAILURE;
+        }
+        result = _verify_set(server, &set, tolerance, repeat, verbose);
+    } else if (strcmp(mode, "compare") == 0) {
+        _generate_set(server, &set, traces, steps, seed);
+        result = _verify_set(server, &set, tolerance, repeat, verbose);
+    } else {
+        _print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    _free_set(&set);
+    map_free(server);
+    return result;
+}
@@ -0,0 +1,268 @@
+// Frozen copy of the scalar player and grenade kernels from Util/Physics.c.
+// This is the oracle spadesx-physics-golden compares Util/Physics.c against, so it must never be optimised or
+// "fixed": any behaviour change here hides the very divergence the harness is meant to catch.
+#include <Bench/ReferencePhysics.h>
+#include <Server/Structs/ServerStruct.h>
+#include <Util/Enums.h>
+#include <libmapvxl/libmapvxl.h>
+#include <math.h>
+
+#define SQRT                 0.70710678f
+#define FALL_SLOW_DOWN       0.24f
+#define FALL_DAMAGE_VELOCITY 0.58f
+#define FALL_DAMAGE_SCALAR   4096
+
+// same as isvoxelsolid but water is empty && out of bounds returns true
+static inline int _ref_clipbox(server_t* server, float x, float y, float z)
+{
+    int sz;
+
+    if (x < 0 || x >= server->s_map.map.size_x || y < 0 || y >= server->s_map.map.size_y)
+        return 1;
+    else if (z < 0)
+        return 0;
+    sz = (int) z;
+    if (sz == server->s_map.map.size_z - 1)
+        sz = server->s_map.map.size_z - 2;
+    else if (sz >= server->s_map.map.size_z)
+        return 1;
+    return mapvxl_is_solid(&server->s_map.map, (int) x, (int) y, sz);
+}
+
+// same as isvoxelsolid but water is empty
+static inline long _ref_clipworld(server_t* server, long x, long y, long z)
+{
+    int sz;
+    if (x < 0 || x >= server->s_map.map.size_x || y < 0 || y >= server->s_map.map.size_y)
+        return 0;
+    if (z < 0)
+        return 0;
+    sz = (int) z;
+    if (sz == server->s_map.map.size_z - 1)
+        sz = server->s_map.map.size_z - 2;
+    else if (sz >= server->s_map.map.size_z - 1)
+        return 1;
+    return mapvxl_is_solid(&server->s_map.map, (int) x, (int) y, sz);
+}
+
+static inline void _ref_reposition_player(player_t* player, const vector3f_t* position, physics_t* physics)
+{
+    float f; /* FIXME meaningful name */
+
+    player->movement.eye_pos = player->movement.position = *position;
+    f = player->lastclimb - physics->ftotclk; /* FIXME meaningful name */
+    if (f > -0.25f)
+        player->movement.eye_pos.z += (f + 0.25f) / 0.25f;
+}
+
+// player movement with autoclimb
+void ref_physics_box_clip_move(server_t* server, player_t* player, physics_t* physics)
+{
+    float offset, m, f, nx, ny, nz, z;
+    long  climb = 0;
+
+    f  = physics->fsynctics * 32.f;
+    nx = f * player->movement.velocity.x + player->movement.position.x;
+    ny = f * player->movement.velocity.y + player->movement.position.y;
+
+    if (player->crouching) {
+        offset = 0.45f;
+        m      = 0.9f;
+    } else {
+        offset = 0.9f;
+        m      = 1.35f;
+    }
+
+    nz = player->movement.position.z + offset;
+
+    if (player->movement.velocity.x < 0)
+        f = -0.45f;
+    else
+        f = 0.45f;
+    z = m;
+    while (z >= -1.36f && !_ref_clipbox(server, nx + f, player->movement.position.y - 0.45f, nz + z) &&
+           !_ref_clipbox(server, nx + f, player->movement.position.y + 0.45f, nz + z))
+        z -= 0.9f;
+    if (z < -1.36f)
+        player->movement.position.x = nx;
+    else if (!player->crouching && player->movement.forward_orientation.z < 0.5f && !player->sprinting) {
+        z = 0.35f;
+        while (z >= -2.36f && !_ref_clipbox(server, nx + f, player->movement.position.y - 0.45f, nz + z) &&
+               !_ref_clipbox(server, nx + f, player->movement.position.y + 0.45f, nz + z))
+            z -= 0.9f;
+        if (z < -2.36f) {
+            player->movement.position.x = nx;
+            climb                       = 1;
+        } else
+            player->movement.velocity.x = 0;
+    } else
+        player->movement.velocity.x = 0;
+
+    if (player->movement.velocity.y < 0)
+        f = -0.45f;
+    else
+        f = 0.45f;
+    z = m;
+    while (z >= -1.36f && !_ref_clipbox(server, player->movement.position.x - 0.45f, ny + f, nz + z) &&
+           !_ref_clipbox(server, player->movement.position.x + 0.45f, ny + f, nz + z))
+        z -= 0.9f;
+    if (z < -1.36f)
+        player->movement.position.y = ny;
+    else if (!player->crouching && player->movement.forward_orientation.z < 0.5f && !player->sprinting && !climb) {
+        z = 0.35f;
+        while (z >= -2.36f && !_ref_clipbox(server, player->movement.position.x - 0.45f, ny + f, nz + z) &&
+               !_ref_clipbox(server, player->movement.position.x + 0.45f, ny + f, nz + z))
+            z -= 0.9f;
+        if (z < -2.36f) {
+            player->movement.position.y = ny;
+            climb                       = 1;
+        } else
+            player->movement.velocity.y = 0;
+    } else if (!climb)
+        player->movement.velocity.y = 0;
+
+    if (climb) {
+        player->movement.velocity.x *= 0.5f;
+        player->movement.velocity.y *= 0.5f;
+        player->lastclimb = physics->ftotclk;
+        nz--;
+        m = -1.35f;
+    } else {
+        if (player->movement.velocity.z < 0)
+            m = -m;
+        nz += player->movement.velocity.z * physics->fsynctics * 32.f;
+    }
+
+    player->airborne = 1;
+
+    if (_ref_clipbox(server, player->movement.position.x - 0.45f, player->movement.position.y - 0.45f, nz + m) ||
+        _ref_clipbox(server, player->movement.position.x - 0.45f, player->movement.position.y + 0.45f, nz + m) ||
+        _ref_clipbox(server, player->movement.position.x + 0.45f, player->movement.position.y - 0.45f, nz + m) ||
+        _ref_clipbox(server, player->movement.position.x + 0.45f, player->movement.position.y + 0.45f, nz + m))
+    {
+        if (player->movement.velocity.z >= 0) {
+            player->wade     = player->movement.position.z > 61;
+            player->airborne = 0;
+        }
+        player->movement.velocity.z = 0;
+    } else
+        player->movement.position.z = nz - offset;
+
+    _ref_reposition_player(player, &player->movement.position, physics);
+}
+
+long ref_physics_move_player(server_t* server, player_t* player, physics_t* physics)
+{
+    float f, f2;
+
+    // move player and perform simple physics (gravity, momentum, friction)
+    if (player->jumping) {
+        player->jumping             = 0;
+        player->movement.velocity.z = -0.36f;
+    }
+
+    f = physics->fsynctics; // player acceleration scalar
+    if (player->airborne)
+        f *= 0.1f;
+    else if (player->crouching)
+        f *= 0.3f;
+    else if ((player->secondary_fire && player->item == TOOL_GUN) || player->sneaking)
+        f *= 0.5f;
+    else if (player->sprinting)
+        f *= 1.3f;
+
+    if ((player->move_forward || player->move_backwards) && (player->move_left || player->move_right))
+        f *= SQRT; // if strafe + forward/backwards then limit diagonal velocity
+
+    if (player->move_forward) {
+        player->movement.velocity.x += player->movement.forward_orientation.x * f;
+        player->movement.velocity.y += player->movement.forward_orientation.y * f;
+    } else if (player->move_backwards) {
+        player->movement.velocity.x -= player->movement.forward_orientation.x * f;
+        player->movement.velocity.y -= player->movement.forward_orientation.y * f;
+    }
+    if (player->move_left) {
+        player->movement.velocity.x -= player->movement.strafe_orientation.x * f;
+        player->movement.velocity.y -= player->movement.strafe_orientation.y * f;
+    } else if (player->move_right) {
+        player->movement.velocity.x += player->movement.strafe_orientation.x * f;
+        player->movement.velocity.y += player->movement.strafe_orientation.y * f;
+    }
+
+    f = physics->fsynctics + 1;
+    player->movement.velocity.z += physics->fsynctics;
+    player->movement.velocity.z /= f; // air friction
+    if (player->wade)
+        f = physics->fsynctics * 6.f + 1; // water friction
+    else if (!player->airborne)
+        f = physics->fsynctics * 4.f + 1; // ground friction
+    player->movement.velocity.x /= f;
+    player->movement.velocity.y /= f;
+    f2 = player->movement.velocity.z;
+    ref_physics_box_clip_move(server, player, physics);
+    // hit ground... check if hurt
+    if (!player->movement.velocity.z && (f2 > FALL_SLOW_DOWN)) {
+        // slow down on landing
+        player->movement.velocity.x *= 0.5f;
+        player->movement.velocity.y *= 0.5f;
+
+        // return fall damage
+        if (f2 > FALL_DAMAGE_VELOCITY) {
+            f2 -= FALL_DAMAGE_VELOCITY;
+            return ((long) (f2 * f2 * FALL_DAMAGE_SCALAR));
+        }
+
+        return (-1); // no fall damage but play fall sound
+    }
+
+    return (0); // no fall damage
+}
+
+int ref_physics_move_grenade(server_t* server, grenade_t* grenade, physics_t* physics)
+{
+    vector3f_t fpos = grenade->position; // old position
+    // do velocity & gravity (friction is negligible)
+    float f = physics->fsynctics * 32;
+    grenade->velocity.z += physics->fsynctics;
+    grenade->position.x += grenade->velocity.x * f;
+    grenade->position.y += grenade->velocity.y * f;
+    grenade->position.z += grenade->velocity.z * f;
+    // do rotation
+    // FIX ME: Loses orientation after 45 degree bounce off wall
+    //  if(g->v.x > 0.1f || g->v.x < -0.1f || g->v.y > 0.1f || g->v.y < -0.1f)
+    //  {
+    //  f *= -0.5;
+    //  }
+    // make it bounce (accurate)
+    vector3l_t lp;
+    lp.x = (long) floor(grenade->position.x);
+    lp.y = (long) floor(grenade->position.y);
+    lp.z = (long) floor(grenade->position.z);
+
+    if (!_ref_clipworld(server, lp.x, lp.y, lp.z)) {
+        return 0; // we didn't hit anything, no collision
+    } else {      // hit a wall
+        static const float BOUNCE_SOUND_THRESHOLD = 1.1f;
+
+        int ret = 1;
+        if (fabsf(grenade->velocity.x) > BOUNCE_SOUND_THRESHOLD ||
+            fabsf(grenade->velocity.y) > BOUNCE_SOUND_THRESHOLD || fabsf(grenade->velocity.z) > BOUNCE_SOUND_THRESHOLD)
+            ret = 2; // play sound
+
+        vector3l_t lp2;
+        lp2.x = (long) floor(fpos.x);
+        lp2.y = (long) floor(fpos.y);
+        lp2.z = (long) floor(fpos.z);
+        if (lp.z != lp2.z && ((lp.x == lp2.x && lp.y == lp2.y) || !_ref_clipworld(server, lp.x, lp.y, lp2.z)))
+            grenade->velocity.z = -grenade->velocity.z;
+        else if (lp.x != lp2.x && ((lp.y == lp2.y && lp.z == lp2.z) || !_ref_clipworld(server, lp2.x, lp.y, lp.z)))
+            grenade->velocity.x = -grenade->velocity.x;
+        else if (lp.y != lp2.y && ((lp.x == lp2.x && lp.z == lp2.z) || !_ref_clipworld(server, lp.x, lp2.y, lp.z)))
+            grenade->velocity.y = -grenade->velocity.y;
+        grenade->position = fpos; // set back to old position
+        grenade->velocity.x *= 0.36f;
+        grenade->velocity.y *= 0.36f;
+        grenade->velocity.z *= 0.36f;
+        return ret;
+    }
+}
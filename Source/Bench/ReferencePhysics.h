@@ -0,0 +1,11 @@
+#ifndef REFERENCE_PHYSICS_H
+#define REFERENCE_PHYSICS_H
+
+#include <Server/Structs/GrenadeStruct.h>
+#include <Server/Structs/ServerStruct.h>
+
+void ref_physics_box_clip_move(server_t* server, player_t* player, physics_t* physics);
+long ref_physics_move_player(server_t* server, player_t* player, physics_t* physics);
+int  ref_physics_move_grenade(server_t* server, grenade_t* grenade, physics_t* physics);
+
+#endif /* REFERENCE_PHYSICS_H */
@@ -2,7 +2,7 @@
 
 #include <Server/Block.h>
 #include <Server/Gamemodes/Gamemodes.h>
-#include <Server/IntelTent.h>
+#include <Server/Map.h>
 #include <Server/Nodes.h>
 #include <Server/Packets/Packets.h>
 #include <Server/Staff.h>
@@ -24,9 +24,9 @@ block_action_build(server_t* server, player_t* player, uint8_t action_type, uint
     {
         return;
     }
-    mapvxl_set_color(&server->s_map.map, X, Y, Z, player->tool_color.raw);
+    map_set_color(server, player->id, X, Y, Z, player->tool_color.raw);
     player->blocks--;
-    moveIntelAndTentUp(server);
+    gamemode_block_built(server);
     send_block_action(server, player, action_type, X, Y, Z);
 }
 
@@ -43,10 +43,10 @@ block_action_destroy_one(server_t* server, player_t* player, uint8_t action_type
 
     vector3i_t  position = {X, Y, Z};
     vector3i_t* neigh    = get_neighbours(position);
-    mapvxl_set_air(&server->s_map.map, position.x, position.y, position.z);
+    map_set_air(server, player->id, position.x, position.y, position.z);
     for (int i = 0; i < 6; ++i) {
         if (neigh[i].z < 62) {
-            check_node(server, neigh[i]);
+            check_node(server, player->id, neigh[i]);
         }
     }
     if (player->item != TOOL_GUN) {
@@ -61,8 +61,8 @@ static void
 block_action_destroy_three(server_t* server, player_t* player, uint8_t action_type, uint32_t X, uint32_t Y, uint32_t Z)
 {
     uint64_t time_now = get_nanos();
-    if (!(gamemode_block_checks(server, X, Y, Z) && gamemode_block_checks(server, X, Y, Z + 1) &&
-        gamemode_block_checks(server, X, Y, Z - 1) && block_action_delay_check(server, player, time_now, action_type, 1)) || player->item == TOOL_GUN)
+    if (!(!map_is_protected(server, X, Y, (int) Z - 1, Z + 1) &&
+        block_action_delay_check(server, player, time_now, action_type, 1)) || player->item == TOOL_GUN)
     {
         return;
     }
@@ -70,13 +70,13 @@ block_action_destroy_three(server_t* server, player_t* player, uint8_t action_ty
         if (z >= 62) {
             continue;
         }
-        mapvxl_set_air(&server->s_map.map, X, Y, z);
+        map_set_air(server, player->id, X, Y, z);
         vector3i_t  position = {X, Y, z};
         vector3i_t* neigh    = get_neighbours(position);
-        mapvxl_set_air(&server->s_map.map, position.x, position.y, position.z);
+        map_set_air(server, player->id, position.x, position.y, position.z);
         for (int i = 0; i < 6; ++i) {
             if (neigh[i].z < 62) {
-                check_node(server, neigh[i]);
+                check_node(server, player->id, neigh[i]);
             }
         }
     }
@@ -8,7 +8,7 @@ void cmd_admin(void* p_server, command_args_t arguments)
     if (arguments.argc > 1) {
         if (arguments.console == 0 && arguments.player->admin_muted == 1) {
             send_server_notice(
-            arguments.player, arguments.console, "You are not allowed to use this command (Admin muted)");
+            server, arguments.player, arguments.console, "You are not allowed to use this command (Admin muted)");
             return;
         }
         if (arguments.console) {
@@ -16,8 +16,8 @@ void cmd_admin(void* p_server, command_args_t arguments)
         } else {
             send_message_to_staff(server, "Staff from %s: %s", arguments.player->name, arguments.argv[1]);
         }
-        send_server_notice(arguments.player, arguments.console, "Message sent to all staff members online");
+        send_server_notice(server, arguments.player, arguments.console, "Message sent to all staff members online");
     } else {
-        send_server_notice(arguments.player, arguments.console, "Invalid message");
+        send_server_notice(server, arguments.player, arguments.console, "Invalid message");
     }
 }
@@ -43,11 +43,11 @@ void cmd_ban_custom(void* p_server, command_args_t arguments)
             } else {
                 cmd_generate_ban(server, arguments, time, ip, reason);
             }
-        } else if (parse_player(arguments.argv[1], &player_id, &reason)) {
+        } else if (parse_player(server, arguments.argv[1], &player_id, &reason)) {
             player_t* player;
             HASH_FIND(hh, server->players, &player_id, sizeof(player_id), player);
             if (player == NULL || player->state == STATE_DISCONNECTED) {
-                send_server_notice(arguments.player, arguments.console, "Player with ID %hhu does not exist");
+                send_server_notice(server, arguments.player, arguments.console, "Player with ID %hhu does not exist");
                 return;
             }
             if (customBan) {
@@ -63,10 +63,11 @@ void cmd_ban_custom(void* p_server, command_args_t arguments)
                 cmd_generate_ban(server, arguments, time, ip, reason);
             }
         } else {
-            send_server_notice(arguments.player, arguments.console, "Invalid IP format");
+            send_server_notice(server, arguments.player, arguments.console, "Invalid IP format");
         }
     } else {
-        send_server_notice(arguments.player, arguments.console, "You did not enter IP or entered incorrect argument");
+        send_server_notice(
+        server, arguments.player, arguments.console, "You did not enter IP or entered incorrect argument");
     }
 }
 
@@ -121,16 +122,18 @@ void cmd_ban_range(void* p_server, command_args_t arguments)
             }
             json_object_array_add(array, ban);
             json_object_to_file("Bans.json", root);
-            send_server_notice(arguments.player,
+            send_server_notice(server,
+                               arguments.player,
                                arguments.console,
                                "IP range %s-%s has been permanently banned",
                                ipStringStart,
                                ipStringEnd);
             json_object_put(root);
         } else {
-            send_server_notice(arguments.player, arguments.console, "Invalid IP format");
+            send_server_notice(server, arguments.player, arguments.console, "Invalid IP format");
         }
     } else {
-        send_server_notice(arguments.player, arguments.console, "You did not enter IP or entered incorrect argument");
+        send_server_notice(
+        server, arguments.player, arguments.console, "You did not enter IP or entered incorrect argument");
     }
 }
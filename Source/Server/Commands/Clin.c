@@ -10,13 +10,13 @@ void cmd_clin(void* p_server, command_args_t arguments)
     server_t* server    = (server_t*) p_server;
     uint8_t   player_id = arguments.console ? 33 : arguments.player->id;
     if (arguments.argc > 2) {
-        send_server_notice(arguments.player, arguments.console, "Too many arguments");
+        send_server_notice(server, arguments.player, arguments.console, "Too many arguments");
         return;
     } else if (arguments.argc != 2 && arguments.console) {
-        send_server_notice(arguments.player, arguments.console, "No ID given");
+        send_server_notice(server, arguments.player, arguments.console, "No ID given");
         return;
-    } else if (arguments.argc == 2 && !parse_player(arguments.argv[1], &player_id, NULL)) {
-        send_server_notice(arguments.player, arguments.console, "Invalid ID. Wrong format");
+    } else if (arguments.argc == 2 && !parse_player(server, arguments.argv[1], &player_id, NULL)) {
+        send_server_notice(server, arguments.player, arguments.console, "Invalid ID. Wrong format");
         return;
     }
 
@@ -35,7 +35,8 @@ void cmd_clin(void* p_server, command_args_t arguments)
             snprintf(client, 7, "Voxlap");
         }
 
-        send_server_notice(arguments.player,
+        send_server_notice(server,
+                           arguments.player,
                            arguments.console,
                            "Player %s is running %s version %d.%d.%d on %s",
                            player->name,
@@ -45,6 +46,6 @@ void cmd_clin(void* p_server, command_args_t arguments)
                            player->version_revision,
                            player->os_info);
     } else {
-        send_server_notice(arguments.player, arguments.console, "Invalid ID. Player doesnt exist");
+        send_server_notice(server, arguments.player, arguments.console, "Invalid ID. Player doesnt exist");
     }
 }
@@ -69,12 +69,112 @@ void cmd_generate_ban(server_t* server, command_args_t arguments, float time, ip
     json_object_to_file("Bans.json", root);
     json_object_put(root);
     if (time == 0) {
-        send_server_notice(arguments.player, arguments.console, "IP %s has been permanently banned", ipString);
+        send_server_notice(server, arguments.player, arguments.console, "IP %s has been permanently banned", ipString);
     } else {
-        send_server_notice(arguments.player, arguments.console, "IP %s has been for %f minutes", ipString, time);
+        send_server_notice(
+        server, arguments.player, arguments.console, "IP %s has been for %f minutes", ipString, time);
     }
 }
 
+static uint32_t _command_hash(const char* id, uint32_t seed)
+{
+    uint32_t hash = 2166136261u ^ (seed * 0x9E3779B9u); // FNV-1a with the seed folded into the offset basis
+    for (; *id != '\0'; ++id) {
+        hash ^= (uint8_t) *id;
+        hash *= 16777619u;
+    }
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+    return hash;
+}
+
+static inline uint32_t _command_bucket(const char* id)
+{
+    return _command_hash(id, 0) & (COMMAND_TABLE_SEEDS - 1);
+}
+
+static inline uint32_t _command_slot(const char* id, uint16_t seed)
+{
+    return _command_hash(id, seed) & (COMMAND_TABLE_SIZE - 1);
+}
+
+static uint8_t _command_table_place(command_table_t* table, command_t* list, uint32_t bucket)
+{
+    command_t* cmd;
+    for (uint32_t seed = 1; seed <= UINT16_MAX; ++seed) {
+        uint8_t placed = 1;
+        LL_FOREACH(list, cmd)
+        {
+            if (_command_bucket(cmd->id) != bucket) {
+                continue;
+            }
+            uint32_t slot = _command_slot(cmd->id, seed);
+            if (table->slots[slot] != NULL) {
+                placed = 0;
+                break;
+            }
+            table->slots[slot] = cmd;
+        }
+        if (placed) {
+            table->seeds[bucket] = seed;
+            return 1;
+        }
+        // Take back what this seed managed to place before trying the next one
+        LL_FOREACH(list, cmd)
+        {
+            if (_command_bucket(cmd->id) == bucket && table->slots[_command_slot(cmd->id, seed)] == cmd) {
+                table->slots[_command_slot(cmd->id, seed)] = NULL;
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+ * Hash and displace: commands are split into buckets by an unseeded hash, then every bucket gets the first seed that
+ * puts all of its commands into free slots. A lookup is two hashes and a single string compare.
+ */
+static uint8_t _command_table_build(server_t* server)
+{
+    command_table_t* table                      = &server->cmds_table;
+    uint8_t          sizes[COMMAND_TABLE_SEEDS] = {0};
+    uint8_t          largest                    = 0;
+    command_t*       cmd;
+
+    memset(table, 0, sizeof(command_table_t));
+    LL_FOREACH(server->cmds_list, cmd)
+    {
+        uint32_t bucket = _command_bucket(cmd->id);
+        if (++sizes[bucket] > largest) {
+            largest = sizes[bucket];
+        }
+    }
+    // The biggest buckets are the hardest to place so they go first
+    for (uint8_t size = largest; size > 0; --size) {
+        for (uint32_t bucket = 0; bucket < COMMAND_TABLE_SEEDS; ++bucket) {
+            if (sizes[bucket] == size && !_command_table_place(table, server->cmds_list, bucket)) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+static command_t* _command_find(server_t* server, const char* id)
+{
+    command_table_t* table = &server->cmds_table;
+    uint16_t         seed  = table->seeds[_command_bucket(id)];
+    if (seed == 0) {
+        return NULL;
+    }
+    command_t* cmd = table->slots[_command_slot(id, seed)];
+    if (cmd == NULL || strcmp(cmd->id, id) != 0) {
+        return NULL;
+    }
+    return cmd;
+}
+
 void command_create(server_t* server,
                     uint8_t   parse_args,
                     void (*command)(void* p_server, command_args_t arguments),
@@ -82,14 +182,23 @@ void command_create(server_t* server,
                     char     description[1024],
                     uint32_t permissions)
 {
+    if (_command_find(server, id) != NULL) {
+        LOG_WARNING("Command %s already exists", id);
+        return;
+    }
     command_t* cmd   = spadesx_malloc(sizeof(command_t));
     cmd->execute     = command;
     cmd->parse_args  = parse_args;
     cmd->permissions = permissions;
     strcpy(cmd->description, description);
     strcpy(cmd->id, id);
-    HASH_ADD_STR(server->cmds_map, id, cmd);
     LL_APPEND(server->cmds_list, cmd);
+    if (!_command_table_build(server)) {
+        LOG_ERROR("No room left in the command table for %s", id);
+        LL_DELETE(server->cmds_list, cmd);
+        free(cmd);
+        _command_table_build(server);
+    }
 }
 
 void command_populate_all(server_t* server)
@@ -119,6 +228,7 @@ void command_populate_all(server_t* server)
     {"/pban", 0, &cmd_ban_custom, 30, "Permanently bans a specified player"},
     {"/pm", 0, &cmd_pm, 0, "Private message to specified player"},
     {"/ratio", 1, &cmd_ratio, 0, "Shows yours or requested player ratio"},
+    {"/reload", 0, &cmd_reload, 24, "Reloads config.toml without restarting the server"},
     {"/reset", 0, &cmd_reset, 24, "Resets server and loads next map"},
     {"/say", 0, &cmd_say, 30, "Send message to everyone as the server"},
     {"/server", 0, &cmd_server, 0, "Shows info about the server"},
@@ -129,6 +239,7 @@ void command_populate_all(server_t* server)
     {"/ttk", 1, &cmd_toggle_team_kill, 30, "Toggles ability to team kill for everyone or specified player"},
     {"/unban", 0, &cmd_unban, 30, "Unbans specified IP"},
     {"/unbanrange", 0, &cmd_unban_range, 30, "Unbans specified IP range"},
+    {"/undo", 1, &cmd_undo, 30, "Reverts the latest block edits of specified player"},
     {"/undoban", 0, &cmd_undo_ban, 30, "Reverts the last ban"},
     {"/ups", 1, &cmd_ups, 0, "Sets UPS of player to requested ammount. Range: 1-300"},
     {"/wban", 0, &cmd_ban_custom, 30, "Bans specified player for a week"},
@@ -149,24 +260,27 @@ void free_all_commands(server_t* server)
     command_t* current_command;
     command_t* tmp;
 
-    HASH_ITER(hh, server->cmds_map, current_command, tmp)
+    LL_FOREACH_SAFE(server->cmds_list, current_command, tmp)
     {
-        command_free(server, current_command);
+        LL_DELETE(server->cmds_list, current_command);
+        free(current_command);
     }
+    memset(&server->cmds_table, 0, sizeof(command_table_t));
 }
 
 void command_free(server_t* server, command_t* command)
 {
-    HASH_DEL(server->cmds_map, command);
     LL_DELETE(server->cmds_list, command);
     free(command);
+    _command_table_build(server);
 }
 
-static uint8_t parse_arguments(command_args_t* arguments, char* message, uint8_t commandLength)
+// Splits the arguments in place, every argument ends up as a null terminated slice of the message
+static uint8_t parse_arguments(command_args_t* arguments, char* p)
 {
-    char* p = message + commandLength; // message beginning + command length
     while (*p != '\0' && arguments->argc < 32) {
-        uint8_t escaped = 0, quotesCount = 0, argument_length;
+        uint8_t escaped = 0, quotesCount = 0;
+        size_t  argument_length;
         while (*p == ' ' || *p == '\t')
             p++; // rewinding
         if (*p == '\0')
@@ -193,14 +307,16 @@ static uint8_t parse_arguments(command_args_t* arguments, char* message, uint8_t
                         break;
                     case '"':
                         if (quotesCount == 0) {
-                            send_server_notice(arguments->player,
+                            send_server_notice(arguments->server,
+                                               arguments->player,
                                                arguments->console,
                                                "Failed to parse the command: found a stray \" symbol");
                             return 0;
                         }
                         char next = *(end + 1);
                         if (next != ' ' && next != '\t' && next != '\0') {
-                            send_server_notice(arguments->player,
+                            send_server_notice(arguments->server,
+                                               arguments->player,
                                                arguments->console,
                                                "Failed to parse the command: found more symbols after the \" symbol");
                             return 0;
@@ -216,8 +332,10 @@ static uint8_t parse_arguments(command_args_t* arguments, char* message, uint8_t
             end++;
         }
         if (quotesCount == 1) {
-            send_server_notice(
-            arguments->player, arguments->console, "Failed to parse the command: missing a \" symbol");
+            send_server_notice(arguments->server,
+                               arguments->player,
+                               arguments->console,
+                               "Failed to parse the command: missing a \" symbol");
             return 0;
         }
     argparse_loop_exit:
@@ -226,13 +344,12 @@ static uint8_t parse_arguments(command_args_t* arguments, char* message, uint8_t
             argument_length--; // don't need that last quote mark
         }
         if (argument_length) {
-            char* argument            = spadesx_malloc(argument_length + 1);
-            // Don't forget about the null terminator!
-            argument[argument_length] = '\0';
-            memcpy(argument, p, argument_length);
-            arguments->argv[arguments->argc++] = argument;
+            arguments->argv[arguments->argc++] = p;
         }
-        p = end;
+        // Terminating the argument overwrites either the closing quote or the separator at end
+        char separator     = *end;
+        p[argument_length] = '\0';
+        p                  = separator == '\0' ? end : end + 1;
     }
     return 1;
 }
@@ -241,20 +358,23 @@ void command_handle(server_t* server, player_t* player, char* message, uint8_t c
 {
     if (strlen(message) > 1000)
     {
-        send_server_notice(player, console, "This command is longer then the 1000 character limit. Thus it has been ignored");
+        send_server_notice(
+        server, player, console, "This command is longer then the 1000 character limit. Thus it has been ignored");
         return;
     }
-    char* command = spadesx_calloc(1000, sizeof(char));
-    sscanf(message, "%s", command);
-    uint8_t command_length = strlen(command);
-    for (uint8_t i = 1; i < command_length; ++i) {
-        message[i] = command[i] = tolower(command[i]);
+    // The command is the first word, split off in place
+    char*  command        = message + strspn(message, " \t\n\v\f\r");
+    size_t command_length = strcspn(command, " \t\n\v\f\r");
+    for (size_t i = 1; i < command_length; ++i) {
+        command[i] = tolower(command[i]);
+    }
+    char* rest = command + command_length;
+    if (*rest != '\0') {
+        *rest++ = '\0';
     }
 
-    command_t* cmd;
-    HASH_FIND_STR(server->cmds_map, command, cmd);
+    command_t* cmd = _command_find(server, command);
     if (cmd == NULL) {
-        free(command);
         return;
     }
 
@@ -266,26 +386,17 @@ void command_handle(server_t* server, player_t* player, char* message, uint8_t c
     arguments.argc        = 1;
     arguments.server = server;
 
-    uint8_t message_length;
     if (cmd->parse_args) {
-        if (!parse_arguments(&arguments, message, command_length)) {
-            goto epic_parsing_fail;
+        if (!parse_arguments(&arguments, rest)) {
+            return;
         }
-    } else if ((message_length = strlen(message)) - command_length > 1)
-    { // if we have something other than the command itself
-        char* argument = spadesx_calloc(message_length - command_length, sizeof(message[0]));
-        strcpy(argument, message + command_length + 1);
-        arguments.argv[arguments.argc++] = argument;
+    } else if (*rest != '\0') { // if we have something other than the command itself
+        arguments.argv[arguments.argc++] = rest;
     }
 
     if (player_has_permission(player, console, cmd->permissions) > 0 || cmd->permissions == 0) {
         cmd->execute((void*) server, arguments);
     } else {
-        send_server_notice(player, console, "You do not have permissions to use this command");
+        send_server_notice(server, player, console, "You do not have permissions to use this command");
     }
-epic_parsing_fail:
-    for (uint8_t i = 1; i < arguments.argc; i++) { // Starting from 1 since we'll free the command anyway
-        free(arguments.argv[i]);
-    }
-    free(command);
 }
@@ -21,6 +21,7 @@ void cmd_master(void* p_server, command_args_t arguments);
 void cmd_mute(void* p_server, command_args_t arguments);
 void cmd_pm(void* p_server, command_args_t arguments);
 void cmd_ratio(void* p_server, command_args_t arguments);
+void cmd_reload(void* p_server, command_args_t arguments);
 void cmd_reset(void* p_server, command_args_t arguments);
 void cmd_say(void* p_server, command_args_t arguments);
 void cmd_server(void* p_server, command_args_t arguments);
@@ -31,6 +32,7 @@ void cmd_tp(void* p_server, command_args_t arguments);
 void cmd_tpc(void* p_server, command_args_t arguments);
 void cmd_unban(void* p_server, command_args_t arguments);
 void cmd_unban_range(void* p_server, command_args_t arguments);
+void cmd_undo(void* p_server, command_args_t arguments);
 void cmd_undo_ban(void* p_server, command_args_t arguments);
 void cmd_ups(void* p_server, command_args_t arguments);
 void cmd_shutdown(void* p_server, command_args_t arguments);
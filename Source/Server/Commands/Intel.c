@@ -9,7 +9,8 @@ void cmd_intel(void* p_server, command_args_t arguments)
     HASH_ITER(hh, server->players, connected_player, tmp)
     {
         if (connected_player->state != STATE_DISCONNECTED && connected_player->has_intel) {
-            send_server_notice(arguments.player,
+            send_server_notice(server,
+                               arguments.player,
                                arguments.console,
                                "Player %s (#%hhu) has intel",
                                connected_player->name,
@@ -20,11 +21,11 @@ void cmd_intel(void* p_server, command_args_t arguments)
     if (sentAtLeastOnce == 0) {
         if (server->protocol.gamemode.intel_held[0]) {
             send_server_notice(
-            arguments.player, arguments.console, "Intel is not being held but intel of team 0 thinks it is");
+            server, arguments.player, arguments.console, "Intel is not being held but intel of team 0 thinks it is");
         } else if (server->protocol.gamemode.intel_held[1]) {
             send_server_notice(
-            arguments.player, arguments.console, "Intel is not being held but intel of team 1 thinks it is");
+            server, arguments.player, arguments.console, "Intel is not being held but intel of team 1 thinks it is");
         }
-        send_server_notice(arguments.player, arguments.console, "Intel is not being held");
+        send_server_notice(server, arguments.player, arguments.console, "Intel is not being held");
     }
 }
@@ -21,11 +21,11 @@ void cmd_inv(void* p_server, command_args_t arguments)
                 send_create_player(server, connected_player, arguments.player);
             }
         }
-        send_server_notice(arguments.player, arguments.console, "You are no longer invisible");
+        send_server_notice(server, arguments.player, arguments.console, "You are no longer invisible");
     } else if (arguments.player->is_invisible == 0) {
         arguments.player->is_invisible  = 1;
         arguments.player->allow_killing = 0;
         send_kill_action_packet(server, arguments.player, arguments.player, 0, 0, 1);
-        send_server_notice(arguments.player, arguments.console, "You are now invisible");
+        send_server_notice(server, arguments.player, arguments.console, "You are now invisible");
     }
 }
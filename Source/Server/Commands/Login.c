@@ -5,7 +5,7 @@
 
 void cmd_login(void* p_server, command_args_t arguments)
 {
-    (void) p_server;
+    server_t* server = (server_t*) p_server;
     if (arguments.console) {
         LOG_INFO("You cannot use this command from console");
         return;
@@ -26,13 +26,14 @@ void cmd_login(void* p_server, command_args_t arguments)
                         && strcmp(password, *arguments.player->role_list[i].access_password) == 0)
                     {
                         arguments.player->permissions |= 1 << arguments.player->role_list[i].perm_level_offset;
-                        send_server_notice(arguments.player,
+                        send_server_notice(server,
+                                           arguments.player,
                                            arguments.console,
                                            "You logged in as %s",
                                            arguments.player->role_list[i].access_level);
                         return;
                     } else {
-                        send_server_notice(arguments.player, arguments.console, "Wrong password");
+                        send_server_notice(server, arguments.player, arguments.console, "Wrong password");
                         return;
                     }
                 } else {
@@ -40,23 +41,23 @@ void cmd_login(void* p_server, command_args_t arguments)
                 }
             }
             if (failed >= sizeof(arguments.player->role_list) / sizeof(permissions_t)) {
-                send_server_notice(arguments.player, arguments.console, "Invalid role");
+                send_server_notice(server, arguments.player, arguments.console, "Invalid role");
             }
         } else {
-            send_server_notice(arguments.player, arguments.console, "Incorrect number of arguments to login");
+            send_server_notice(server, arguments.player, arguments.console, "Incorrect number of arguments to login");
         }
     } else {
-        send_server_notice(arguments.player, arguments.console, "You are already logged in");
+        send_server_notice(server, arguments.player, arguments.console, "You are already logged in");
     }
 }
 
 void cmd_logout(void* p_server, command_args_t arguments)
 {
-    (void) p_server;
+    server_t* server = (server_t*) p_server;
     if (arguments.console) {
         LOG_INFO("You cannot use this command from console");
         return;
     }
     arguments.player->permissions = 0;
-    send_server_notice(arguments.player, arguments.console, "You logged out");
+    send_server_notice(server, arguments.player, arguments.console, "You logged out");
 }
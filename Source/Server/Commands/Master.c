@@ -8,10 +8,10 @@ void cmd_master(void* p_server, command_args_t arguments)
     if (server->master.enable_master_connection == 1) {
         server->master.enable_master_connection = 0;
         enet_host_destroy(server->master.client);
-        send_server_notice(arguments.player, arguments.console, "Disabling master connection");
+        send_server_notice(server, arguments.player, arguments.console, "Disabling master connection");
         return;
     }
     server->master.enable_master_connection = 1;
     master_connect(server, server->port);
-    send_server_notice(arguments.player, arguments.console, "Enabling master connection");
+    send_server_notice(server, arguments.player, arguments.console, "Enabling master connection");
 }
@@ -8,24 +8,27 @@ void cmd_admin_mute(void* p_server, command_args_t arguments)
 {
     server_t* server = (server_t*) p_server;
     uint8_t   ID     = 33;
-    if (arguments.argc == 2 && parse_player(arguments.argv[1], &ID, NULL)) {
+    if (arguments.argc == 2 && parse_player(server, arguments.argv[1], &ID, NULL)) {
         player_t* player;
         HASH_FIND(hh, server->players, &ID, sizeof(ID), player);
         if (player == NULL) {
-            send_server_notice(arguments.player, arguments.console, "ID not in range or player doesnt exist");
+            send_server_notice(server, arguments.player, arguments.console, "ID not in range or player doesnt exist");
             return;
         }
         if (is_past_join_screen(player)) {
             if (player->admin_muted) {
                 player->admin_muted = 0;
-                send_server_notice(arguments.player, arguments.console, "%s has been admin unmuted", player->name);
+                send_server_notice(
+                server, arguments.player, arguments.console, "%s has been admin unmuted", player->name);
             } else {
                 player->admin_muted = 1;
-                send_server_notice(arguments.player, arguments.console, "%s has been admin muted", player->name);
+                send_server_notice(
+                server, arguments.player, arguments.console, "%s has been admin muted", player->name);
             }
         }
     } else {
-        send_server_notice(arguments.player, arguments.console, "You did not enter ID or entered incorrect argument");
+        send_server_notice(
+        server, arguments.player, arguments.console, "You did not enter ID or entered incorrect argument");
     }
 }
 
@@ -33,11 +36,11 @@ void cmd_mute(void* p_server, command_args_t arguments)
 {
     server_t* server = (server_t*) p_server;
     uint8_t   ID     = 33;
-    if (arguments.argc == 2 && parse_player(arguments.argv[1], &ID, NULL)) {
+    if (arguments.argc == 2 && parse_player(server, arguments.argv[1], &ID, NULL)) {
         player_t* player;
         HASH_FIND(hh, server->players, &ID, sizeof(ID), player);
         if (player == NULL) {
-            send_server_notice(arguments.player, arguments.console, "ID not in range or player doesnt exist");
+            send_server_notice(server, arguments.player, arguments.console, "ID not in range or player doesnt exist");
             return;
         }
         if (is_past_join_screen(player)) {
@@ -50,6 +53,7 @@ void cmd_mute(void* p_server, command_args_t arguments)
             }
         }
     } else {
-        send_server_notice(arguments.player, arguments.console, "You did not enter ID or entered incorrect argument");
+        send_server_notice(
+        server, arguments.player, arguments.console, "You did not enter ID or entered incorrect argument");
     }
 }
@@ -0,0 +1,10 @@
+#include <Server/Config.h>
+#include <Server/Server.h>
+#include <Util/Notice.h>
+
+void cmd_reload(void* p_server, command_args_t arguments)
+{
+    server_t* server = (server_t*) p_server;
+    config_request_reload(server);
+    send_server_notice(server, arguments.player, arguments.console, "Reloading %s", CONFIG_PATH);
+}
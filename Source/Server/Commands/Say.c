@@ -10,10 +10,10 @@ void cmd_say(void* p_server, command_args_t arguments)
         HASH_ITER(hh, server->players, connected_player, tmp)
         {
             if (is_past_join_screen(connected_player)) {
-                send_server_notice(connected_player, 0, arguments.argv[1]);
+                send_server_notice(server, connected_player, 0, arguments.argv[1]);
             }
         }
     } else {
-        send_server_notice(arguments.player, arguments.console, "Invalid message");
+        send_server_notice(server, arguments.player, arguments.console, "Invalid message");
     }
 }
@@ -3,6 +3,7 @@
 
 void cmd_server(void* p_server, command_args_t arguments)
 {
-    (void) p_server;
-    send_server_notice(arguments.player, arguments.console, "You are playing on SpadesX server. Version %s", VERSION);
+    server_t* server = (server_t*) p_server;
+    send_server_notice(
+    server, arguments.player, arguments.console, "You are playing on SpadesX server. Version %s", VERSION);
 }
@@ -14,14 +14,14 @@ void cmd_tp(void* p_server, command_args_t arguments)
     }
     uint8_t to_be_teleported = 33;
     uint8_t to_teleport_to   = 33;
-    if (arguments.argc == 3 && parse_player(arguments.argv[1], &to_be_teleported, NULL) &&
-        parse_player(arguments.argv[2], &to_teleport_to, NULL))
+    if (arguments.argc == 3 && parse_player(server, arguments.argv[1], &to_be_teleported, NULL) &&
+        parse_player(server, arguments.argv[2], &to_teleport_to, NULL))
     {
         player_t *player_to_be_teleported, *player_to_teleport_to;
         HASH_FIND(hh, server->players, &to_teleport_to, sizeof(to_teleport_to), player_to_teleport_to);
         HASH_FIND(hh, server->players, &to_be_teleported, sizeof(to_be_teleported), player_to_be_teleported);
         if (player_to_teleport_to == NULL || player_to_be_teleported == NULL) {
-            send_server_notice(arguments.player, arguments.console, "ID not in range or player doesnt exist");
+            send_server_notice(server, arguments.player, arguments.console, "ID not in range or player doesnt exist");
             return;
         }
         if (valid_pos_v3f(server, player_to_teleport_to->movement.position)) {
@@ -33,10 +33,11 @@ void cmd_tp(void* p_server, command_args_t arguments)
             send_position_packet(server, player_to_be_teleported, from->position.x, from->position.y, from->position.z);
         } else {
             send_server_notice(
-            arguments.player, arguments.console, "Player %hhu is at invalid position", player_to_teleport_to);
+            server, arguments.player, arguments.console, "Player %hhu is at invalid position", player_to_teleport_to);
         }
     } else {
-        send_server_notice(arguments.player, arguments.console, "Incorrect amount of arguments or wrong argument type");
+        send_server_notice(
+        server, arguments.player, arguments.console, "Incorrect amount of arguments or wrong argument type");
     }
 }
 
@@ -59,9 +60,10 @@ void cmd_tpc(void* p_server, command_args_t arguments)
                                  arguments.player->movement.position.y,
                                  arguments.player->movement.position.z);
         } else {
-            send_server_notice(arguments.player, arguments.console, "Invalid position");
+            send_server_notice(server, arguments.player, arguments.console, "Invalid position");
         }
     } else {
-        send_server_notice(arguments.player, arguments.console, "Incorrect amount of arguments or wrong argument type");
+        send_server_notice(
+        server, arguments.player, arguments.console, "Incorrect amount of arguments or wrong argument type");
     }
 }
@@ -15,11 +15,11 @@ void cmd_toggle_build(void* p_server, command_args_t arguments)
             server->global_ab = 1;
             broadcast_server_notice(server, arguments.console, "Building has been enabled");
         }
-    } else if (parse_player(arguments.argv[1], &ID, NULL)) {
+    } else if (parse_player(server, arguments.argv[1], &ID, NULL)) {
         player_t* player;
         HASH_FIND(hh, server->players, &ID, sizeof(ID), player);
         if (player == NULL) {
-            send_server_notice(arguments.player, arguments.console, "ID not in range or player doesnt exist");
+            send_server_notice(server, arguments.player, arguments.console, "ID not in range or player doesnt exist");
             return;
         }
         if (is_past_join_screen(player)) {
@@ -46,11 +46,11 @@ void cmd_toggle_kill(void* p_server, command_args_t arguments)
             server->global_ak = 1;
             broadcast_server_notice(server, arguments.console, "Killing has been enabled");
         }
-    } else if (parse_player(arguments.argv[1], &ID, NULL)) {
+    } else if (parse_player(server, arguments.argv[1], &ID, NULL)) {
         player_t* player;
         HASH_FIND(hh, server->players, &ID, sizeof(ID), player);
         if (player == NULL) {
-            send_server_notice(arguments.player, arguments.console, "ID not in range or player doesnt exist");
+            send_server_notice(server, arguments.player, arguments.console, "ID not in range or player doesnt exist");
             return;
         }
         if (is_past_join_screen(player)) {
@@ -69,11 +69,11 @@ void cmd_toggle_team_kill(void* p_server, command_args_t arguments)
 {
     server_t* server = (server_t*) p_server;
     uint8_t   ID     = 33;
-    if (arguments.argc == 2 && parse_player(arguments.argv[1], &ID, NULL)) {
+    if (arguments.argc == 2 && parse_player(server, arguments.argv[1], &ID, NULL)) {
         player_t* player;
         HASH_FIND(hh, server->players, &ID, sizeof(ID), player);
         if (player == NULL) {
-            send_server_notice(arguments.player, arguments.console, "ID not in range or player doesnt exist");
+            send_server_notice(server, arguments.player, arguments.console, "ID not in range or player doesnt exist");
             return;
         }
         if (is_past_join_screen(player)) {
@@ -87,7 +87,7 @@ void cmd_toggle_team_kill(void* p_server, command_args_t arguments)
                 server, arguments.console, "Team killing has been enabled for %s", player->name);
             }
         } else {
-            send_server_notice(arguments.player, arguments.console, "ID not in range or player doesnt exist");
+            send_server_notice(server, arguments.player, arguments.console, "ID not in range or player doesnt exist");
         }
     }
 }
@@ -7,7 +7,7 @@
 
 void cmd_unban(void* p_server, command_args_t arguments)
 {
-    (void) p_server;
+    server_t* server = (server_t*) p_server;
     ip_t ip;
     if (arguments.argc == 2 && parse_ip(arguments.argv[1], &ip, NULL)) {
         uint8_t             unbanned = 0;
@@ -28,19 +28,20 @@ void cmd_unban(void* p_server, command_args_t arguments)
             }
         }
         if (unbanned) {
-            send_server_notice(arguments.player, arguments.console, "IP %s unbanned", unbanIPString);
+            send_server_notice(server, arguments.player, arguments.console, "IP %s unbanned", unbanIPString);
         } else {
-            send_server_notice(arguments.player, arguments.console, "IP %s not found in banned IP list", unbanIPString);
+            send_server_notice(
+            server, arguments.player, arguments.console, "IP %s not found in banned IP list", unbanIPString);
         }
         json_object_put(root);
     } else {
-        send_server_notice(arguments.player, arguments.console, "Incorrect amount of arguments or invalid IP");
+        send_server_notice(server, arguments.player, arguments.console, "Incorrect amount of arguments or invalid IP");
     }
 }
 
 void cmd_unban_range(void* p_server, command_args_t arguments)
 {
-    (void) p_server;
+    server_t* server = (server_t*) p_server;
     ip_t  start_range, end_range;
     char* end;
     if (arguments.argc == 2 && parse_ip(arguments.argv[1], &start_range, &end) && parse_ip(end, &end_range, NULL)) {
@@ -68,13 +69,15 @@ void cmd_unban_range(void* p_server, command_args_t arguments)
             }
         }
         if (unbanned) {
-            send_server_notice(arguments.player,
+            send_server_notice(server,
+                               arguments.player,
                                arguments.console,
                                "IP range %s-%s unbanned",
                                unban_start_range_string,
                                unban_end_range_string);
         } else {
-            send_server_notice(arguments.player,
+            send_server_notice(server,
+                               arguments.player,
                                arguments.console,
                                "IP range %s-%s not found in banned IP ranges",
                                unban_start_range_string,
@@ -82,13 +85,13 @@ void cmd_unban_range(void* p_server, command_args_t arguments)
         }
         json_object_put(root);
     } else {
-        send_server_notice(arguments.player, arguments.console, "Incorrect amount of arguments or invalid IP");
+        send_server_notice(server, arguments.player, arguments.console, "Incorrect amount of arguments or invalid IP");
     }
 }
 
 void cmd_undo_ban(void* p_server, command_args_t arguments)
 {
-    (void) p_server;
+    server_t* server = (server_t*) p_server;
     if (arguments.argc == 1) {
         const char*         ip_string;
         const char*         start_ip;
@@ -102,16 +105,17 @@ void cmd_undo_ban(void* p_server, command_args_t arguments)
         if (ip_string[0] == '0') {
             READ_STR_FROM_JSON(objectAtIndex, start_ip, start_of_range, "start of range", "0.0.0.0", 0);
             READ_STR_FROM_JSON(objectAtIndex, end_ip, end_of_range, "end of range", "0.0.0.0", 0);
-            send_server_notice(arguments.player, arguments.console, "IP range %s-%s unbanned", start_ip, end_ip);
+            send_server_notice(
+            server, arguments.player, arguments.console, "IP range %s-%s unbanned", start_ip, end_ip);
             json_object_array_del_idx(array, count - 1, 1);
             json_object_to_file("Bans.json", root);
         } else {
-            send_server_notice(arguments.player, arguments.console, "IP %s unbanned", ip_string);
+            send_server_notice(server, arguments.player, arguments.console, "IP %s unbanned", ip_string);
             json_object_array_del_idx(array, count - 1, 1);
             json_object_to_file("Bans.json", root);
         }
         json_object_put(root);
     } else {
-        send_server_notice(arguments.player, arguments.console, "Too many arguments given to command");
+        send_server_notice(server, arguments.player, arguments.console, "Too many arguments given to command");
     }
 }
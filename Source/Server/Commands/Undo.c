@@ -0,0 +1,86 @@
+#include <Server/Commands/Commands.h>
+#include <Server/Map.h>
+#include <Server/Nodes.h>
+#include <Server/Packets/Packets.h>
+#include <Server/ParseConvert.h>
+#include <Server/Server.h>
+#include <Util/Log.h>
+#include <Util/Notice.h>
+#include <stdlib.h>
+
+typedef struct undo_context
+{
+    block_painter_t painter;
+    vector3i_t*     removed; // Voxels turned back into air, their neighbours may be floating now
+    uint32_t        count;
+    uint32_t        capacity;
+} undo_context_t;
+
+static void _undo_restored(server_t* server, void* arg, vector3i_t position, uint8_t solid, uint32_t color)
+{
+    undo_context_t* context = (undo_context_t*) arg;
+    send_restored_block(server, &context->painter, position, solid, color);
+    if (solid) {
+        return;
+    }
+    if (context->count == context->capacity) {
+        uint32_t    capacity = context->capacity == 0 ? 64 : context->capacity * 2;
+        vector3i_t* removed  = (vector3i_t*) realloc(context->removed, capacity * sizeof(vector3i_t));
+        if (removed == NULL) {
+            LOG_ERROR("Out of memory, blocks left floating by /undo are not removed");
+            return;
+        }
+        context->removed  = removed;
+        context->capacity = capacity;
+    }
+    context->removed[context->count++] = position;
+}
+
+void cmd_undo(void* p_server, command_args_t arguments)
+{
+    server_t* server = (server_t*) p_server;
+    uint8_t   ID     = 33;
+    if (arguments.argc < 2 || arguments.argc > 3 || !parse_player(server, arguments.argv[1], &ID, NULL) ||
+        ID >= PLAYER_SLOTS)
+    {
+        send_server_notice(server, arguments.player, arguments.console, "Usage: /undo #<player id> [number of edits]");
+        return;
+    }
+
+    // Edits stay under the ID after the player left until somebody else gets it, so it does not have to be connected
+    uint32_t edits = MAP_JOURNAL_SIZE;
+    if (arguments.argc == 3) {
+        char* end;
+        edits = strtoul(arguments.argv[2], &end, 10);
+        if (*end != '\0' || edits == 0) {
+            send_server_notice(
+            server, arguments.player, arguments.console, "Invalid number of edits \"%s\"", arguments.argv[2]);
+            return;
+        }
+    }
+
+    undo_context_t context = {0};
+    if (!block_painter_init(server, &context.painter)) {
+        send_server_notice(
+        server, arguments.player, arguments.console, "Server is full, cannot send the reverted blocks");
+        return;
+    }
+    int64_t reverted = map_undo(server, ID, edits, _undo_restored, &context);
+
+    // Clients drop floating blocks on their own when they see a voxel destroyed, same as for a player's edit
+    for (uint32_t i = 0; i < context.count; ++i) {
+        vector3i_t* neigh = get_neighbours(context.removed[i]);
+        for (int j = 0; j < 6; ++j) {
+            if (neigh[j].z < 62) {
+                check_node(server, MAP_EDITOR_SERVER, neigh[j]);
+            }
+        }
+    }
+    free(context.removed);
+    send_server_notice(server,
+                       arguments.player,
+                       arguments.console,
+                       "Reverted %lld blocks edited by player #%hhu",
+                       (long long) reverted,
+                       ID);
+}
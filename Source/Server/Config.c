@@ -0,0 +1,360 @@
+#include <Server/Config.h>
+#include <Server/RateControl.h>
+#include <Server/Server.h>
+#include <Server/Structs/ServerStruct.h>
+#include <Util/Enums.h>
+#include <Util/Log.h>
+#include <Util/Types.h>
+#include <Util/Uthash.h>
+#include <Util/Utlist.h>
+#include <Util/Alloc.h>
+#include <enet/enet.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <tomlc99/toml.h>
+#include <Util/TOMLHelpers.h>
+
+// A bad file on reload has to be rejected instead of taking the server down
+#undef TOMLH_ON_ERROR
+#define TOMLH_ON_ERROR goto done
+
+static void _string_nodes_free(string_node_t* root)
+{
+    string_node_t *el, *tmp;
+    DL_FOREACH_SAFE(root, el, tmp)
+    {
+        free(el->string);
+        DL_DELETE(root, el);
+        free(el);
+    }
+}
+
+config_t* config_load(const char* path)
+{
+    // Numbers are read as int and range checked before they go into narrower fields
+    int         port;
+    uint8_t     master;
+    int         gamemode;
+    int         capture_limit;
+    const char* manager_passwd    = NULL;
+    const char* admin_passwd      = NULL;
+    const char* mod_passwd        = NULL;
+    const char* guard_passwd      = NULL;
+    const char* trusted_passwd    = NULL;
+    const char* server_name       = NULL;
+    const char* team1_name        = NULL;
+    const char* team2_name        = NULL;
+    const char* rotation_mode_str = NULL;
+    color_t     team1_color;
+    color_t     team2_color;
+    uint8_t     periodic_delays[5];
+    uint8_t     adaptive_ups;
+    int         min_ups;
+    int         ups_delay_limit;
+    int         ups_loss_limit;
+    int         ups_backlog_limit;
+    int         egress_bandwidth;
+    int         egress_peer_bandwidth;
+    uint8_t     soft_reset;
+    int         soft_reset_max_blocks;
+    int         plugin_budget;
+
+    string_node_t* map_list              = NULL;
+    string_node_t* welcome_message_list  = NULL;
+    string_node_t* periodic_message_list = NULL;
+    string_node_t* plugin_list           = NULL;
+
+    size_t map_list_len              = 0;
+    size_t welcome_message_list_len  = 0;
+    size_t periodic_message_list_len = 0;
+    size_t plugin_list_len           = 0;
+
+    uint8_t       valid  = 0;
+    config_t*     config = spadesx_calloc(1, sizeof(config_t));
+    toml_table_t* parsed = NULL;
+    toml_table_t* server_table;
+    TOMLH_READ_FROM_FILE(parsed, path);
+    TOMLH_GET_TABLE(parsed, server_table, "server");
+
+    /* [server] */
+    TOMLH_GET_STRING(server_table, server_name, "name", "SpadesX server", 0);
+    TOMLH_GET_INT(server_table, port, "port", DEFAULT_SERVER_PORT, 0);
+    TOMLH_GET_BOOL(server_table, master, "master", 1, 0);
+    TOMLH_GET_INT(server_table, gamemode, "gamemode", 0, 0);
+    TOMLH_GET_INT(server_table, capture_limit, "capture_limit", 10, 0);
+
+    TOMLH_GET_STRING_ARRAY_AS_DL(server_table, map_list, map_list_len, "maps", 0);
+
+    if (map_list_len == 0 || map_list_len > UINT8_MAX) {
+        LOG_ERROR("Between 1 and %d maps have to be defined in the [server] maps array of %s", UINT8_MAX, path);
+        goto done;
+    }
+
+    // Get map rotation mode
+    TOMLH_GET_STRING(server_table, rotation_mode_str, "map_rotation_mode", "toml", 0);
+    if (strcmp(rotation_mode_str, "alphabetic") == 0) {
+        config->rotation_mode = MAP_ROTATION_ALPHABETIC;
+    } else if (strcmp(rotation_mode_str, "random") == 0) {
+        config->rotation_mode = MAP_ROTATION_RANDOM;
+    } else if (strcmp(rotation_mode_str, "toml") == 0) {
+        config->rotation_mode = MAP_ROTATION_TOML_DEFINED;
+    } else {
+        LOG_WARNING("Unknown map_rotation_mode '%s', defaulting to toml", rotation_mode_str);
+        config->rotation_mode = MAP_ROTATION_TOML_DEFINED;
+    }
+
+    TOMLH_GET_INT_ARRAY(server_table, periodic_delays, "periodic_delays", 5, ((uint8_t[]){1, 5, 10, 30, 60}), 1);
+    TOMLH_GET_STRING_ARRAY_AS_DL(server_table, welcome_message_list, welcome_message_list_len, "welcome_messages", 1);
+    TOMLH_GET_STRING_ARRAY_AS_DL(server_table, periodic_message_list, periodic_message_list_len, "periodic_messages", 1);
+
+    TOMLH_GET_BOOL(server_table, adaptive_ups, "adaptive_ups", 1, 1);
+    TOMLH_GET_INT(server_table, min_ups, "min_ups", 20, 1);
+    TOMLH_GET_INT(server_table, ups_delay_limit, "ups_delay_limit", 100, 1);
+    TOMLH_GET_INT(server_table, ups_loss_limit, "ups_loss_limit", 5, 1);
+    TOMLH_GET_INT(server_table, ups_backlog_limit, "ups_backlog_limit", 16384, 1);
+    TOMLH_GET_INT(server_table, egress_bandwidth, "egress_bandwidth", 0, 1);
+    TOMLH_GET_INT(server_table, egress_peer_bandwidth, "egress_peer_bandwidth", 0, 1);
+    TOMLH_GET_BOOL(server_table, soft_reset, "soft_reset", 1, 1);
+    TOMLH_GET_INT(server_table, soft_reset_max_blocks, "soft_reset_max_blocks", 20000, 1);
+    TOMLH_GET_STRING_ARRAY_AS_DL(server_table, plugin_list, plugin_list_len, "plugins", 1);
+    TOMLH_GET_INT(server_table, plugin_budget, "plugin_budget", 2000, 1);
+
+    if (port < 1 || port > UINT16_MAX) {
+        LOG_ERROR("port in %s has to be between 1 and %d", path, UINT16_MAX);
+        goto done;
+    }
+    if (gamemode < 0 || gamemode > GAME_MODE_ARENA) {
+        LOG_ERROR("gamemode in %s has to be between 0 and %d", path, GAME_MODE_ARENA);
+        goto done;
+    }
+    if (capture_limit < 1 || capture_limit > UINT8_MAX) {
+        LOG_ERROR("capture_limit in %s has to be between 1 and %d", path, UINT8_MAX);
+        goto done;
+    }
+    if (welcome_message_list_len > UINT8_MAX || periodic_message_list_len > UINT8_MAX) {
+        LOG_ERROR("At most %d welcome and periodic messages can be defined in %s", UINT8_MAX, path);
+        goto done;
+    }
+    if (min_ups < RATE_CONTROL_MIN_UPS || min_ups > RATE_CONTROL_MAX_UPS) {
+        LOG_ERROR("min_ups in %s has to be between %d and %d", path, RATE_CONTROL_MIN_UPS, RATE_CONTROL_MAX_UPS);
+        goto done;
+    }
+    if (ups_loss_limit < 0 || ups_loss_limit > 100) {
+        LOG_ERROR("ups_loss_limit in %s is a percentage and has to be between 0 and 100", path);
+        goto done;
+    }
+    if (ups_delay_limit < 0 || ups_backlog_limit < 0 || egress_bandwidth < 0 || egress_peer_bandwidth < 0 ||
+        soft_reset_max_blocks < 0 || plugin_budget < 0)
+    {
+        LOG_ERROR("ups limits, egress bandwidths, soft_reset_max_blocks and plugin_budget in %s cannot be negative",
+                  path);
+        goto done;
+    }
+
+    /* [teams] */
+    toml_table_t* teams_table;
+    toml_table_t* team1_table;
+    toml_table_t* team2_table;
+    TOMLH_GET_TABLE(parsed, teams_table, "teams");
+
+    TOMLH_GET_TABLE(teams_table, team1_table, "team1");
+    TOMLH_GET_STRING(team1_table, team1_name, "name", "Blue Team", 0);
+    TOMLH_GET_RGB_COLOR(team1_table, team1_color, "color", ((uint8_t[]){0, 0, 255}), 0);
+
+    TOMLH_GET_TABLE(teams_table, team2_table, "team2");
+    TOMLH_GET_STRING(team2_table, team2_name, "name", "Red Team", 0);
+    TOMLH_GET_RGB_COLOR(team2_table, team2_color, "color", ((uint8_t[]){255, 0, 0}), 0);
+
+    /* [passwords] */
+    toml_table_t* passwords_table;
+    TOMLH_GET_TABLE(parsed, passwords_table, "passwords");
+    TOMLH_GET_STRING(passwords_table, manager_passwd, "manager", "", 0);
+    TOMLH_GET_STRING(passwords_table, admin_passwd, "admin", "", 0);
+    TOMLH_GET_STRING(passwords_table, mod_passwd, "moderator", "", 0);
+    TOMLH_GET_STRING(passwords_table, guard_passwd, "guard", "", 0);
+    TOMLH_GET_STRING(passwords_table, trusted_passwd, "trusted", "", 0);
+
+    config->team1_color           = team1_color;
+    config->team2_color           = team2_color;
+    config->rate_control          = (rate_control_config_t) {.enabled       = adaptive_ups,
+                                                             .min_ups       = min_ups,
+                                                             .delay_limit   = ups_delay_limit,
+                                                             .loss_limit    = (uint32_t) ups_loss_limit *
+                                                                           ENET_PEER_PACKET_LOSS_SCALE / 100,
+                                                             .backlog_limit = ups_backlog_limit};
+    config->egress_bandwidth      = egress_bandwidth;
+    config->egress_peer_bandwidth = egress_peer_bandwidth;
+    config->soft_reset_limit      = soft_reset_max_blocks;
+    config->plugin_budget         = plugin_budget;
+    config->port                  = port;
+    config->master                = master;
+    config->gamemode              = gamemode;
+    config->capture_limit         = capture_limit;
+    config->soft_reset            = soft_reset;
+    memcpy(config->periodic_delays, periodic_delays, sizeof(config->periodic_delays));
+    valid = 1;
+
+done:
+    // Whatever was read so far belongs to the snapshot, so an invalid one is freed in one place
+    config->map_list               = map_list;
+    config->welcome_messages       = welcome_message_list;
+    config->periodic_messages      = periodic_message_list;
+    config->plugin_list            = plugin_list;
+    config->map_count              = map_list_len;
+    config->welcome_message_count  = welcome_message_list_len;
+    config->periodic_message_count = periodic_message_list_len;
+    config->server_name            = (char*) server_name;
+    config->team1_name             = (char*) team1_name;
+    config->team2_name             = (char*) team2_name;
+    config->manager_password       = (char*) manager_passwd;
+    config->admin_password         = (char*) admin_passwd;
+    config->mod_password           = (char*) mod_passwd;
+    config->guard_password         = (char*) guard_passwd;
+    config->trusted_password       = (char*) trusted_passwd;
+    free((char*) rotation_mode_str);
+    if (parsed != NULL) {
+        toml_free(parsed);
+    }
+    if (!valid) {
+        config_free(config);
+        return NULL;
+    }
+    return config;
+}
+
+void config_free(config_t* config)
+{
+    _string_nodes_free(config->map_list);
+    _string_nodes_free(config->welcome_messages);
+    _string_nodes_free(config->periodic_messages);
+    _string_nodes_free(config->plugin_list);
+    free(config->server_name);
+    free(config->team1_name);
+    free(config->team2_name);
+    free(config->manager_password);
+    free(config->admin_password);
+    free(config->mod_password);
+    free(config->guard_password);
+    free(config->trusted_password);
+    free(config);
+}
+
+void config_request_reload(server_t* server)
+{
+    server->config_reload.requested = 1;
+}
+
+static void* _config_loader(void* arg)
+{
+    config_reload_t* reload = &((server_t*) arg)->config_reload;
+    reload->pending         = config_load(CONFIG_PATH);
+    __atomic_store_n(&reload->state, CONFIG_RELOAD_DONE, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void _config_warn_restart(const config_t* current, const config_t* next)
+{
+    if (next->port != current->port || next->gamemode != current->gamemode || next->master != current->master ||
+        strcmp(next->server_name, current->server_name) != 0 || strcmp(next->team1_name, current->team1_name) != 0 ||
+        strcmp(next->team2_name, current->team2_name) != 0 ||
+        memcmp(&next->team1_color, &current->team1_color, sizeof(color_t)) != 0 ||
+        memcmp(&next->team2_color, &current->team2_color, sizeof(color_t)) != 0)
+    {
+        LOG_WARNING("Changes to the port, gamemode, master, server name or teams only apply after a restart");
+    }
+}
+
+static void _config_swap(server_t* server, config_t* config)
+{
+    config_t* previous = server->config;
+    _config_warn_restart(previous, config);
+
+    server->manager_passwd         = config->manager_password;
+    server->admin_passwd           = config->admin_password;
+    server->mod_passwd             = config->mod_password;
+    server->guard_passwd           = config->guard_password;
+    server->trusted_passwd         = config->trusted_password;
+    server->welcome_messages       = config->welcome_messages;
+    server->welcome_messages_count = config->welcome_message_count;
+    server->periodic_messages      = config->periodic_messages;
+    server->periodic_message_count = config->periodic_message_count;
+    server->periodic_delays        = config->periodic_delays;
+    server->capture_limit          = config->capture_limit;
+    server->rate_control           = config->rate_control;
+    server->egress.rate            = config->egress_bandwidth * 1024;
+    server->egress.peer_rate       = config->egress_peer_bandwidth * 1024;
+    server->s_map.soft_reset       = config->soft_reset;
+    server->s_map.soft_reset_limit = config->soft_reset_limit;
+    // The map being played follows the new limit unless it has one of its own
+    if (!server->s_map.own_capture_limit) {
+        server->protocol.gamemode.score_limit = config->capture_limit;
+    }
+
+    // Keep rotating from the map being played, or start over when it is no longer in the list
+    string_node_t* current = NULL;
+    if (server->s_map.current_map != NULL) {
+        string_node_t* map;
+        DL_FOREACH(config->map_list, map)
+        {
+            if (strcmp(map->string, server->s_map.current_map->string) == 0) {
+                current = map;
+                break;
+            }
+        }
+    }
+    server->s_map.current_map   = current;
+    server->s_map.map_list      = config->map_list;
+    server->s_map.map_count     = config->map_count;
+    server->s_map.rotation_mode = config->rotation_mode;
+
+    player_t *player, *tmp;
+    HASH_ITER(hh, server->players, player, tmp)
+    {
+        player->current_periodic_message = server->periodic_messages;
+    }
+
+    server->config = config;
+    config_free(previous);
+    LOG_STATUS("Reloaded %s", CONFIG_PATH);
+}
+
+void config_update(server_t* server)
+{
+    config_reload_t* reload = &server->config_reload;
+    uint8_t          state  = __atomic_load_n(&reload->state, __ATOMIC_ACQUIRE);
+
+    if (state == CONFIG_RELOAD_DONE) {
+        pthread_join(reload->loader, NULL);
+        config_t* config = reload->pending;
+        reload->pending  = NULL;
+        __atomic_store_n(&reload->state, CONFIG_RELOAD_IDLE, __ATOMIC_RELAXED);
+        if (config == NULL) {
+            LOG_ERROR("Keeping the current configuration, %s was rejected", CONFIG_PATH);
+        } else {
+            _config_swap(server, config);
+        }
+    } else if (state == CONFIG_RELOAD_IDLE && reload->requested) {
+        reload->requested = 0;
+        __atomic_store_n(&reload->state, CONFIG_RELOAD_LOADING, __ATOMIC_RELAXED);
+        if (pthread_create(&reload->loader, NULL, _config_loader, (void*) server) != 0) {
+            LOG_ERROR("Failed to start reloading %s", CONFIG_PATH);
+            __atomic_store_n(&reload->state, CONFIG_RELOAD_IDLE, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+void config_stop(server_t* server)
+{
+    config_reload_t* reload = &server->config_reload;
+    if (__atomic_load_n(&reload->state, __ATOMIC_ACQUIRE) == CONFIG_RELOAD_IDLE) {
+        return;
+    }
+    pthread_join(reload->loader, NULL);
+    if (reload->pending != NULL) {
+        config_free(reload->pending);
+        reload->pending = NULL;
+    }
+    __atomic_store_n(&reload->state, CONFIG_RELOAD_IDLE, __ATOMIC_RELAXED);
+}
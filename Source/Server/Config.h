@@ -0,0 +1,40 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include <Server/Structs/ConfigStruct.h>
+#include <Server/Structs/ServerStruct.h>
+
+#define CONFIG_PATH "config.toml"
+
+/**
+ * @brief Parse and validate a config file into a new snapshot
+ *
+ * Errors are logged and never exit, so this is safe to call on a running server.
+ *
+ * @return The snapshot or NULL if the file is missing or invalid
+ */
+config_t* config_load(const char* path);
+
+void config_free(config_t* config);
+
+/**
+ * @brief Ask for config.toml to be reloaded, safe to call from a signal handler
+ */
+void config_request_reload(server_t* server);
+
+/**
+ * @brief Start a requested reload on a loader thread and swap in its result, called at the start of every update
+ *
+ * Passwords, welcome and periodic messages, the map list and rotation mode, rate control, egress bandwidth, the
+ * capture limit and soft resets take effect right away. Everything else needs a restart. The capture limit does not
+ * apply to a map whose TOML sets its own, and players already connected keep seeing the old one until the next map
+ * as the protocol only sends it on join.
+ */
+void config_update(server_t* server);
+
+/**
+ * @brief Wait for a reload that is still loading and drop its result, called on shutdown before config_free
+ */
+void config_stop(server_t* server);
+
+#endif
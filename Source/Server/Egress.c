@@ -0,0 +1,158 @@
+#include <Server/Egress.h>
+#include <Server/Structs/ServerStruct.h>
+#include <Util/Enums.h>
+#include <Util/Log.h>
+#include <Util/Nanos.h>
+#include <Util/Uthash.h>
+#include <enet/enet.h>
+
+static inline int64_t _burst(uint32_t rate)
+{
+    int64_t burst = (int64_t) rate * EGRESS_BURST_MS / 1000;
+    return burst < EGRESS_MIN_BURST ? EGRESS_MIN_BURST : burst;
+}
+
+static inline uint8_t _has_budget(server_t* server, player_t* player)
+{
+    return (server->egress.rate == 0 || server->egress.tokens > 0) &&
+           (server->egress.peer_rate == 0 || player->egress.tokens > 0);
+}
+
+static inline void _charge(server_t* server, player_t* player, uint32_t size)
+{
+    // Gameplay may push the buckets below zero, everything else then waits until they refill
+    if (server->egress.rate != 0 && server->egress.tokens > -_burst(server->egress.rate)) {
+        server->egress.tokens -= size;
+    }
+    if (server->egress.peer_rate != 0 && player->egress.tokens > -_burst(server->egress.peer_rate)) {
+        player->egress.tokens -= size;
+    }
+}
+
+static inline void _release(ENetPacket* packet)
+{
+    if (--packet->referenceCount == 0) {
+        enet_packet_destroy(packet);
+    }
+}
+
+static int _send_now(server_t* server, player_t* player, ENetPacket* packet)
+{
+    uint32_t size = packet->dataLength;
+    if (enet_peer_send(player->peer, 0, packet) != 0) {
+        return -1;
+    }
+    _charge(server, player, size);
+    return 0;
+}
+
+static uint8_t _queues_empty(player_t* player)
+{
+    for (uint8_t i = 0; i < EGRESS_QUEUED_CLASSES; ++i) {
+        if (player->egress.queues[i].count != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int egress_send(server_t* server, player_t* player, ENetPacket* packet, egress_class_t egress_class)
+{
+    if (egress_class == EGRESS_GAMEPLAY || egress_class > EGRESS_QUEUED_CLASSES) {
+        return _send_now(server, player, packet);
+    }
+
+    egress_queue_t* queue = &player->egress.queues[egress_class - 1];
+    if (queue->count == 0 && _has_budget(server, player)) {
+        return _send_now(server, player, packet);
+    }
+
+    if (queue->count == EGRESS_QUEUE_SIZE) {
+        if (egress_class == EGRESS_CHAT) {
+            server->egress.dropped++;
+            return -1;
+        }
+        // Never lose a block edit, the client map would go out of sync. Send the oldest one over budget instead.
+        ENetPacket* oldest = queue->packets[queue->head];
+        queue->head        = (queue->head + 1) & (EGRESS_QUEUE_SIZE - 1);
+        queue->count--;
+        _send_now(server, player, oldest);
+        _release(oldest);
+    }
+
+    // Hold a reference so a caller broadcasting the same packet does not see it freed before we send it
+    packet->referenceCount++;
+    queue->packets[(queue->head + queue->count) & (EGRESS_QUEUE_SIZE - 1)] = packet;
+    queue->count++;
+    server->egress.deferred++;
+    return 0;
+}
+
+uint8_t egress_reserve(server_t* server, player_t* player, egress_class_t egress_class, uint32_t size)
+{
+    if (egress_class != EGRESS_GAMEPLAY && (!_queues_empty(player) || !_has_budget(server, player))) {
+        return 0;
+    }
+    _charge(server, player, size);
+    return 1;
+}
+
+static void _refill(int64_t* tokens, uint32_t rate, uint64_t elapsed)
+{
+    if (rate == 0) {
+        return;
+    }
+    int64_t burst = _burst(rate);
+    *tokens += (int64_t) ((uint64_t) rate * elapsed / NANO_IN_SECOND);
+    if (*tokens > burst) {
+        *tokens = burst;
+    }
+}
+
+void egress_flush(server_t* server)
+{
+    uint64_t time_now = get_nanos();
+    uint64_t elapsed  = time_now - server->egress.last_refill;
+    // Refill in whole milliseconds so the integer math does not lose budget at high loop rates
+    if (elapsed < NANO_IN_MILLI) {
+        elapsed = 0;
+    } else {
+        server->egress.last_refill = time_now;
+        _refill(&server->egress.tokens, server->egress.rate, elapsed);
+    }
+
+    player_t *player, *tmp;
+    HASH_ITER(hh, server->players, player, tmp)
+    {
+        if (elapsed != 0) {
+            _refill(&player->egress.tokens, server->egress.peer_rate, elapsed);
+        }
+        for (uint8_t i = 0; i < EGRESS_QUEUED_CLASSES; ++i) {
+            egress_queue_t* queue = &player->egress.queues[i];
+            while (queue->count > 0 && _has_budget(server, player)) {
+                ENetPacket* packet = queue->packets[queue->head];
+                queue->head        = (queue->head + 1) & (EGRESS_QUEUE_SIZE - 1);
+                queue->count--;
+                _send_now(server, player, packet);
+                _release(packet);
+            }
+            if (queue->count > 0) {
+                break; // Lower classes wait until this one is drained
+            }
+        }
+    }
+}
+
+void egress_reset(player_t* player)
+{
+    for (uint8_t i = 0; i < EGRESS_QUEUED_CLASSES; ++i) {
+        egress_queue_t* queue = &player->egress.queues[i];
+        while (queue->count > 0) {
+            _release(queue->packets[queue->head]);
+            queue->head = (queue->head + 1) & (EGRESS_QUEUE_SIZE - 1);
+            queue->count--;
+        }
+        queue->head = 0;
+    }
+    player->egress.tokens = 0;
+}
@@ -0,0 +1,33 @@
+#ifndef EGRESS_H
+#define EGRESS_H
+
+#include <Server/Structs/ServerStruct.h>
+
+// How many milliseconds worth of budget a bucket can save up
+#define EGRESS_BURST_MS 100
+// Lowest bucket size so a single map chunk always fits
+#define EGRESS_MIN_BURST 8192
+
+/**
+ * @brief Send a packet to a player through the egress scheduler
+ *
+ * Gameplay packets go out immediately and are charged to the budgets. Block edits and chat are sent right away while
+ * the player has budget and nothing of the same class waiting, otherwise they are queued until egress_flush.
+ *
+ * @return 0 when the packet was sent or queued, negative like enet_peer_send otherwise
+ */
+int egress_send(server_t* server, player_t* player, ENetPacket* packet, egress_class_t egress_class);
+
+/**
+ * @brief Reserve budget for a packet of the given size that the caller is about to send
+ *
+ * Used for map chunks, which are only sent once nothing of higher priority is waiting for the player.
+ *
+ * @return 1 if the caller may send now
+ */
+uint8_t egress_reserve(server_t* server, player_t* player, egress_class_t egress_class, uint32_t size);
+
+void egress_flush(server_t* server);
+void egress_reset(player_t* player);
+
+#endif
@@ -1,4 +1,17 @@
 #include <Server/Events.h>
 #include <Server/Structs/ServerStruct.h>
 
+EVENT_DEFINITION(player_connect, (server, player), player_t* player)
 EVENT_DEFINITION(player_disconnect, (server, player), player_t* player)
+EVENT_DEFINITION(player_spawn, (server, player), player_t* player)
+EVENT_DEFINITION(player_kill, (server, killer, victim, reason), player_t* killer, player_t* victim, uint8_t reason)
+EVENT_DEFINITION(block_change,
+                 (server, editor, position, solid, color),
+                 uint8_t    editor,
+                 vector3i_t position,
+                 uint8_t    solid,
+                 uint32_t   color)
+EVENT_DEFINITION(grenade_explode, (server, player, position), player_t* player, vector3f_t position)
+EVENT_DEFINITION(chat, (server, player, meant_for, message), player_t* player, uint8_t meant_for, const char* message)
+EVENT_DEFINITION(tick_begin, (server, tick), uint64_t tick)
+EVENT_DEFINITION(tick_end, (server, tick), uint64_t tick)
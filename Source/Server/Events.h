@@ -3,12 +3,13 @@
 #define EVENTS_H
 
 #include <Server/Structs/PlayerStruct.h>
-#include <Util/Alloc.h>
 #include <Util/Log.h>
-#include <Util/Utlist.h>
+#include <Util/Nanos.h>
+#include <Util/Types.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 // return values for a callback:
 enum {
@@ -19,6 +20,9 @@ enum {
 // where to insert the callback:
 enum { EVENT_FIRST, EVENT_LAST };
 
+// Listeners one event can have at once
+#define EVENT_MAX_LISTENERS 16
+
 // This macro contains forward declarations of the event functions and should be called in a header.
 //
 // Arguments:
@@ -27,67 +31,150 @@ enum { EVENT_FIRST, EVENT_LAST };
 //
 // Defined types:
 // - int [event]Callback([callbackArguments]) - describes a callback function
-// - struct [event]Listener - an element of the callback linked list
-//
-// Defined global variables:
-// - struct [event]Listener *g_[event]Listeners - a linked list of callbacks for given event
+// - struct [event]Listeners - the callbacks of the event in the order they run, stored in server->event_handlers
 //
 // Defined functions:
-// - void [event]_subscribe([event]Callback callback, int position) - adds a callback to the list. Position is either
-// EVENT_FIRST or EVENT_LAST
-// - void [event]_unsubscribe([event]Callback callback) - find given callback in the list and remove it if it's present
-// - void [event]_run(...) - called when the event had occured. Calls every callback until either callback returns
-// EVENT_BREAK or there will be no more callbacks in the list
-#define EVENT(event, ...)                                                                  \
-    typedef int (*event##Callback)(server_t * server, __VA_ARGS__);                        \
-    typedef struct event##Listener_t                                                       \
-    {                                                                                      \
-        event##Callback           callback;                                                \
-        struct event##Listener_t* next;                                                    \
-    } event##Listener_t;                                                                   \
-                                                                                           \
-    void on_##event##_subscribe(server_t* server, event##Callback callback, int position); \
-    void on_##event##_unsubscribe(server_t* server, event##Callback callback);             \
-    void on_##event##_run(server_t* server, __VA_ARGS__);
-
-// This macro defines the functions and a global list of callbacks and should be calleed in a source file.
+// - uint8_t on_[event]_subscribe(server, [event]Callback callback, int position) - adds a callback to the list.
+// Position is either EVENT_FIRST or EVENT_LAST. Returns 0 when the event has EVENT_MAX_LISTENERS already
+// - uint8_t on_[event]_subscribe_metered(server, [event]Callback callback, int position, uint64_t* meter) - same,
+// and every call of the callback adds the nanoseconds it took to *meter. Used by the plugin host
+// - void on_[event]_unsubscribe(server, [event]Callback callback) - find given callback in the list and remove it if
+// it's present
+// - void on_[event]_unsubscribe_any(server, void (*callback)(void)) - same, for callers that keep callbacks of
+// different events in one place, like the plugin host
+// - void on_[event]_run(server, ...) - calls every callback until either callback returns EVENT_BREAK or there will
+// be no more callbacks in the list. Raise events with EVENT_RUN rather than calling this directly
+#define EVENT(event, ...)                                                                     \
+    typedef int (*event##Callback)(server_t * server, __VA_ARGS__);                           \
+    typedef struct event##Listeners                                                           \
+    {                                                                                         \
+        event##Callback callbacks[EVENT_MAX_LISTENERS];                                       \
+        uint64_t*       meters[EVENT_MAX_LISTENERS];                                          \
+        uint8_t         count;                                                                \
+    } event##Listeners_t;                                                                     \
+                                                                                              \
+    uint8_t on_##event##_subscribe(server_t* server, event##Callback callback, int position); \
+    uint8_t on_##event##_subscribe_metered(                                                   \
+    server_t* server, event##Callback callback, int position, uint64_t* meter);               \
+    void    on_##event##_unsubscribe(server_t* server, event##Callback callback);             \
+    void    on_##event##_unsubscribe_any(server_t* server, void (*callback)(void));           \
+    void    on_##event##_run(server_t* server, __VA_ARGS__);
+
+// This macro defines the functions and should be calleed in a source file.
 // Arguments:
 // - event - same as EVENT
 // - argumentNames - same as ... in EVENT but in brackets and without the type names, pointer signs etc (example: (Name,
 // Number, Data))
 // - ... - same as EVENT
-#define EVENT_DEFINITION(event, argumentNames, ...)                                       \
-    void on_##event##_subscribe(server_t* server, event##Callback callback, int position) \
-    {                                                                                     \
-        event##Listener_t* el;                                                            \
-        el           = spadesx_malloc(sizeof *el);                                        \
-        el->callback = callback;                                                          \
-        if (position == EVENT_LAST)                                                       \
-            LL_APPEND(server->event_handlers.event, el);                                  \
-        else                                                                              \
-            LL_PREPEND(server->event_handlers.event, el);                                 \
-    }                                                                                     \
-                                                                                          \
-    void on_##event##_unsubscribe(server_t* server, event##Callback callback)             \
-    {                                                                                     \
-        event##Listener_t* el;                                                            \
-        LL_SEARCH_SCALAR(server->event_handlers.event, el, callback, callback);           \
-        if (!el)                                                                          \
-            return;                                                                       \
-        LL_DELETE(server->event_handlers.event, el);                                      \
-        free(el);                                                                         \
-    }                                                                                     \
-                                                                                          \
-    void on_##event##_run(server_t* server, __VA_ARGS__)                                  \
-    {                                                                                     \
-        event##Listener_t* el;                                                            \
-        el = server->event_handlers.event;                                                \
-        while (el && el->callback argumentNames != EVENT_BREAK)                           \
-            el = el->next;                                                                \
+#define EVENT_DEFINITION(event, argumentNames, ...)                                              \
+    uint8_t on_##event##_subscribe_metered(                                                      \
+    server_t* server, event##Callback callback, int position, uint64_t* meter)                   \
+    {                                                                                            \
+        event##Listeners_t* listeners = &server->event_handlers.event;                           \
+        if (listeners->count == EVENT_MAX_LISTENERS) {                                           \
+            LOG_WARNING("Event " #event " already has %d listeners", EVENT_MAX_LISTENERS);       \
+            return 0;                                                                            \
+        }                                                                                        \
+        if (position == EVENT_LAST) {                                                            \
+            listeners->callbacks[listeners->count] = callback;                                   \
+            listeners->meters[listeners->count]    = meter;                                      \
+        } else {                                                                                 \
+            memmove(&listeners->callbacks[1], &listeners->callbacks[0],                          \
+                    listeners->count * sizeof(event##Callback));                                 \
+            memmove(&listeners->meters[1], &listeners->meters[0],                                \
+                    listeners->count * sizeof(uint64_t*));                                       \
+            listeners->callbacks[0] = callback;                                                  \
+            listeners->meters[0]    = meter;                                                     \
+        }                                                                                        \
+        listeners->count++;                                                                      \
+        return 1;                                                                                \
+    }                                                                                            \
+                                                                                                 \
+    uint8_t on_##event##_subscribe(server_t* server, event##Callback callback, int position)     \
+    {                                                                                            \
+        return on_##event##_subscribe_metered(server, callback, position, NULL);                 \
+    }                                                                                            \
+                                                                                                 \
+    void on_##event##_unsubscribe(server_t* server, event##Callback callback)                    \
+    {                                                                                            \
+        event##Listeners_t* listeners = &server->event_handlers.event;                           \
+        for (uint8_t i = 0; i < listeners->count; ++i) {                                         \
+            if (listeners->callbacks[i] == callback) {                                           \
+                listeners->count--;                                                              \
+                memmove(&listeners->callbacks[i], &listeners->callbacks[i + 1],                  \
+                        (listeners->count - i) * sizeof(event##Callback));                       \
+                memmove(&listeners->meters[i], &listeners->meters[i + 1],                        \
+                        (listeners->count - i) * sizeof(uint64_t*));                             \
+                return;                                                                          \
+            }                                                                                    \
+        }                                                                                        \
+    }                                                                                            \
+                                                                                                 \
+    void on_##event##_unsubscribe_any(server_t* server, void (*callback)(void))                  \
+    {                                                                                            \
+        on_##event##_unsubscribe(server, (event##Callback) callback);                            \
+    }                                                                                            \
+                                                                                                 \
+    void on_##event##_run(server_t* server, __VA_ARGS__)                                         \
+    {                                                                                            \
+        event##Listeners_t* listeners = &server->event_handlers.event;                           \
+        for (uint8_t i = 0; i < listeners->count; ++i) {                                         \
+            uint64_t* meter = listeners->meters[i];                                              \
+            if (meter == NULL) {                                                                 \
+                if (listeners->callbacks[i] argumentNames == EVENT_BREAK) {                      \
+                    break;                                                                       \
+                }                                                                                \
+                continue;                                                                        \
+            }                                                                                    \
+            uint64_t before = get_nanos();                                                       \
+            int      result = listeners->callbacks[i] argumentNames;                             \
+            *meter += get_nanos() - before;                                                      \
+            if (result == EVENT_BREAK) {                                                         \
+                break;                                                                           \
+            }                                                                                    \
+        }                                                                                        \
     }
 
+// Raise an event. While nobody listens this is a single branch, the arguments are not even evaluated
+#define EVENT_RUN(server, event, ...)                           \
+    do {                                                        \
+        if ((server)->event_handlers.event.count != 0) {        \
+            on_##event##_run((server), __VA_ARGS__);            \
+        }                                                       \
+    } while (0)
+
+// Happens when a player connected and got a player slot.
+// Arguments: player struct pointer
+EVENT(player_connect, player_t* player)
+
 // Happens when a player disconnects.
 // Arguments: player struct pointer
 EVENT(player_disconnect, player_t* player)
 
+// Happens when a player was (re)spawned and everybody was sent the create player packet.
+// Arguments: player struct pointer
+EVENT(player_spawn, player_t* player)
+
+// Happens when a player was killed.
+// Arguments: killer and victim (the same player for suicides and fall damage), kill reason
+EVENT(player_kill, player_t* killer, player_t* victim, uint8_t reason)
+
+// Happens right before a voxel of the map changes. Writes that change nothing do not raise it. Voxels put back by
+// /undo and by soft resets raise it as well, under MAP_EDITOR_SERVER.
+// Arguments: player id or MAP_EDITOR_SERVER, position, whether the voxel will be solid, its new colour
+EVENT(block_change, uint8_t editor, vector3i_t position, uint8_t solid, uint32_t color)
+
+// Happens when a grenade explodes, before any blocks are destroyed.
+// Arguments: player that threw it, position of the explosion
+EVENT(grenade_explode, player_t* player, vector3f_t position)
+
+// Happens when a chat message passed every check and is about to be sent.
+// Arguments: sender, chat type (global, team or system), message
+EVENT(chat, player_t* player, uint8_t meant_for, const char* message)
+
+// Happen around every physics tick.
+// Arguments: number of the tick
+EVENT(tick_begin, uint64_t tick)
+EVENT(tick_end, uint64_t tick)
+
 #endif
@@ -0,0 +1,164 @@
+#include <Server/Gamemodes/Arena.h>
+#include <Server/Map.h>
+#include <Server/Packets/Packets.h>
+#include <Server/Player.h>
+#include <Server/Server.h>
+#include <Server/Structs/ServerStruct.h>
+#include <Util/Checks/PlayerChecks.h>
+#include <Util/Enums.h>
+#include <Util/Log.h>
+#include <Util/Nanos.h>
+#include <Util/Notice.h>
+#include <Util/Utlist.h>
+#include <stdlib.h>
+
+static void _set_state(server_t* server, arena_state_t state)
+{
+    server->protocol.gamemode.arena.state       = state;
+    server->protocol.gamemode.arena.state_since = get_nanos();
+}
+
+void arena_init(server_t* server)
+{
+    server->protocol.gamemode.score[0]    = 0;
+    server->protocol.gamemode.score[1]    = 0;
+    server->protocol.gamemode.intel_flags = 0;
+
+    // Nothing to capture in arena, keep the intel and tents out of reach
+    vector3f_t hidden = {0, 0, 64};
+    for (uint8_t team = 0; team < 2; ++team) {
+        server->protocol.gamemode.intel[team]      = hidden;
+        server->protocol.gamemode.base[team]       = hidden;
+        server->protocol.gamemode.intel_held[team] = 0;
+        send_move_object(server, team, team, hidden);
+        send_move_object(server, team + 2, team, hidden);
+    }
+    _set_state(server, ARENA_WAITING);
+}
+
+uint8_t arena_can_spawn(server_t* server, player_t* player)
+{
+    return player->team == TEAM_SPECTATOR || server->protocol.gamemode.arena.state == ARENA_WAITING;
+}
+
+static void _start_round(server_t* server)
+{
+    // Put the map back the way the last round found it. Too many changes to replay make everybody download the same
+    // map again, the match goes on with the score it had
+    block_painter_t painter;
+    if (!block_painter_init(server, &painter) ||
+        map_restore(server, server->s_map.soft_reset_limit, send_restored_block, &painter) < 0)
+    {
+        LOG_STATUS("Too many blocks changed for a quick round restart, reloading the map");
+        uint8_t score[2] = {server->protocol.gamemode.score[0], server->protocol.gamemode.score[1]};
+        server_map_reload(server);
+        server->protocol.gamemode.score[0] = score[0];
+        server->protocol.gamemode.score[1] = score[1];
+        return;
+    }
+
+    // Everybody spawns at once: refill and place them all, then send every create player packet in one pass
+    player_t* spawning[PLAYER_SLOTS];
+    uint8_t   count = 0;
+    player_t *player, *tmp;
+    HASH_ITER(hh, server->players, player, tmp)
+    {
+        grenade_t *grenade, *tmp_grenade;
+        DL_FOREACH_SAFE(player->grenade, grenade, tmp_grenade)
+        {
+            DL_DELETE(player->grenade, grenade);
+            free(grenade);
+        }
+        if (is_past_join_screen(player) && player->team != TEAM_SPECTATOR && count < PLAYER_SLOTS) {
+            player_prepare_spawn(server, player);
+            spawning[count++] = player;
+        }
+    }
+    send_respawn_many(server, spawning, count);
+    _set_state(server, ARENA_PLAYING);
+    broadcast_server_notice(server, 0, "Round started");
+}
+
+static void _count_team(server_t* server, uint8_t team, uint8_t* players, uint8_t* alive)
+{
+    uint32_t members = server->protocol.team_members[team];
+    *players         = 0;
+    *alive           = 0;
+    while (members != 0) {
+        player_t* player = server->players_by_id[__builtin_ctz(members)];
+        members &= members - 1;
+        if (player == NULL || !is_past_join_screen(player)) {
+            continue;
+        }
+        (*players)++;
+        if (player->state == STATE_READY && player->alive) {
+            (*alive)++;
+        }
+    }
+}
+
+void arena_tick(server_t* server)
+{
+    arena_t* arena = &server->protocol.gamemode.arena;
+    // Nothing changes between physics ticks
+    if (arena->last_check_tick == server->global_timers.ticks) {
+        return;
+    }
+    arena->last_check_tick = server->global_timers.ticks;
+
+    uint8_t players[2];
+    uint8_t alive[2];
+    _count_team(server, TEAM_A, &players[0], &alive[0]);
+    _count_team(server, TEAM_B, &players[1], &alive[1]);
+    uint64_t elapsed = get_nanos() - arena->state_since;
+
+    if (players[0] == 0 || players[1] == 0) {
+        if (arena->state != ARENA_WAITING) {
+            _set_state(server, ARENA_WAITING);
+            broadcast_server_notice(server, 0, "Waiting for players on both teams");
+        }
+        return;
+    }
+
+    switch (arena->state) {
+        case ARENA_WAITING:
+            _set_state(server, ARENA_COUNTDOWN);
+            broadcast_server_notice(server, 0, "Next round starts in %d seconds", ARENA_COUNTDOWN_SECONDS);
+            break;
+        case ARENA_COUNTDOWN:
+            if (elapsed >= (uint64_t) ARENA_COUNTDOWN_SECONDS * NANO_IN_SECOND) {
+                _start_round(server);
+            }
+            break;
+        case ARENA_PLAYING:
+        {
+            if (alive[0] != 0 && alive[1] != 0) {
+                break;
+            }
+            if (alive[0] == 0 && alive[1] == 0) {
+                broadcast_server_notice(server, 0, "Round ended in a draw");
+                _set_state(server, ARENA_ENDING);
+                break;
+            }
+            uint8_t winner = (alive[0] != 0) ? TEAM_A : TEAM_B;
+            server->protocol.gamemode.score[winner]++;
+            broadcast_server_notice(server,
+                                    0,
+                                    "%s won the round (%hhu - %hhu)",
+                                    server->protocol.name_team[winner],
+                                    server->protocol.gamemode.score[0],
+                                    server->protocol.gamemode.score[1]);
+            if (server->protocol.gamemode.score[winner] >= server->protocol.gamemode.score_limit) {
+                server_round_reset(server);
+                return;
+            }
+            _set_state(server, ARENA_ENDING);
+            break;
+        }
+        case ARENA_ENDING:
+            if (elapsed >= (uint64_t) ARENA_END_SECONDS * NANO_IN_SECOND) {
+                _start_round(server);
+            }
+            break;
+    }
+}
@@ -0,0 +1,24 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <Server/Structs/ServerStruct.h>
+
+#define ARENA_COUNTDOWN_SECONDS 5
+#define ARENA_END_SECONDS       3
+
+/**
+ * @brief Hide the intel and tents and wait for players on both teams
+ */
+void arena_init(server_t* server);
+
+/**
+ * @brief Drive the round state machine, start rounds and decide who won them
+ */
+void arena_tick(server_t* server);
+
+/**
+ * @brief Players only respawn while there are not enough of them for a round
+ */
+uint8_t arena_can_spawn(server_t* server, player_t* player);
+
+#endif
@@ -1,5 +1,9 @@
+#include <Server/Gamemodes/Arena.h>
 #include <Server/Gamemodes/Gamemodes.h>
+#include <Server/Gamemodes/TerritoryControl.h>
 #include <Server/IntelTent.h>
+#include <Server/Map.h>
+#include <Server/Packets/Packets.h>
 #include <Server/Structs/ServerStruct.h>
 #include <Util/Enums.h>
 #include <Util/Log.h>
@@ -11,38 +15,35 @@
 
 uint8_t grenadeGamemodeCheck(server_t* server, vector3f_t pos)
 {
-    if (gamemode_block_checks(server, pos.x + 1, pos.y + 1, pos.z + 1) &&
-        gamemode_block_checks(server, pos.x + 1, pos.y + 1, pos.z - 1) &&
-        gamemode_block_checks(server, pos.x + 1, pos.y + 1, pos.z) &&
-        gamemode_block_checks(server, pos.x + 1, pos.y - 1, pos.z + 1) &&
-        gamemode_block_checks(server, pos.x + 1, pos.y - 1, pos.z - 1) &&
-        gamemode_block_checks(server, pos.x + 1, pos.y - 1, pos.z) &&
-        gamemode_block_checks(server, pos.x - 1, pos.y + 1, pos.z + 1) &&
-        gamemode_block_checks(server, pos.x - 1, pos.y + 1, pos.z - 1) &&
-        gamemode_block_checks(server, pos.x - 1, pos.y + 1, pos.z) &&
-        gamemode_block_checks(server, pos.x - 1, pos.y - 1, pos.z + 1) &&
-        gamemode_block_checks(server, pos.x - 1, pos.y - 1, pos.z - 1) &&
-        gamemode_block_checks(server, pos.x - 1, pos.y - 1, pos.z))
+    // The four corner columns of the blast, each checked over all three levels at once
+    int z_from = pos.z - 1;
+    int z_to   = pos.z + 1;
+    if (map_is_protected(server, pos.x + 1, pos.y + 1, z_from, z_to) ||
+        map_is_protected(server, pos.x + 1, pos.y - 1, z_from, z_to) ||
+        map_is_protected(server, pos.x - 1, pos.y + 1, z_from, z_to) ||
+        map_is_protected(server, pos.x - 1, pos.y - 1, z_from, z_to))
     {
-        return 1;
+        return 0;
     }
-    return 0;
+    return 1;
 }
 
 uint8_t gamemode_block_checks(server_t* server, int x, int y, int z)
 {
-    if (((((x >= 206 && x <= 306) && (y >= 240 && y <= 272) && (z == 2 || z == 0)) ||
-          ((x >= 205 && x <= 307) && (y >= 239 && y <= 273) && (z == 1))) &&
-         server->protocol.current_gamemode == GAME_MODE_BABEL))
-    {
-        return 0;
-    }
-    return 1;
+    return !map_is_protected(server, x, y, z, z);
+}
+
+// Players that stay connected over a soft reset never get new state data, move the objects for them
+static void _send_intel_and_tents(server_t* server)
+{
+    send_move_object(server, 0, 0, server->protocol.gamemode.intel[0]);
+    send_move_object(server, 1, 1, server->protocol.gamemode.intel[1]);
+    send_move_object(server, 2, 0, server->protocol.gamemode.base[0]);
+    send_move_object(server, 3, 1, server->protocol.gamemode.base[1]);
 }
 
 static void _init_ctf(server_t* server)
 {
-    memcpy(server->gamemode_name, "ctf", strlen("ctf") + 1);
     // Init CTF
     server->protocol.gamemode.score[0]    = 0;
     server->protocol.gamemode.score[1]    = 0;
@@ -60,18 +61,11 @@ static void _init_ctf(server_t* server)
     server->protocol.gamemode.base[0].y = floorf(server->protocol.gamemode.base[0].y);
     server->protocol.gamemode.base[1].x = floorf(server->protocol.gamemode.base[1].x);
     server->protocol.gamemode.base[1].y = floorf(server->protocol.gamemode.base[1].y);
-}
-
-static void _init_tc(server_t* server)
-{
-    memcpy(server->gamemode_name, "tc", strlen("tc") + 1);
-    LOG_WARNING("GameMode not supported properly yet");
-    server->running = 0;
+    _send_intel_and_tents(server);
 }
 
 static void _init_babel(server_t* server)
 {
-    memcpy(server->gamemode_name, "babel", strlen("babel") + 1);
     // Init CTF
     server->protocol.gamemode.score[0]    = 0;
     server->protocol.gamemode.score[1]    = 0;
@@ -82,9 +76,17 @@ static void _init_babel(server_t* server)
 
     for (int x = 206; x <= 306; ++x) {
         for (int y = 240; y <= 272; ++y) {
-            mapvxl_set_color(&server->s_map.map, x, y, 1, platformColor.raw);
+            map_set_color(server, MAP_EDITOR_SERVER, x, y, 1, platformColor.raw);
         }
     }
+
+    // The platform and the level it sits on, with a one block border around it
+    vector3i_t protectFrom = {206, 240, 0};
+    vector3i_t protectTo   = {306, 272, 2};
+    vector3i_t borderFrom  = {205, 239, 1};
+    vector3i_t borderTo    = {307, 273, 1};
+    map_protect_box(server, protectFrom, protectTo);
+    map_protect_box(server, borderFrom, borderTo);
     // intel
     server->protocol.gamemode.intel[0].z =
     mapvxl_find_top_block(&server->s_map.map, 255, 255); // We still need highest point of map. While this is 0 for
@@ -107,29 +109,51 @@ static void _init_babel(server_t* server)
     server->protocol.gamemode.base[0].y = floorf(server->protocol.gamemode.base[0].y);
     server->protocol.gamemode.base[1].x = floorf(server->protocol.gamemode.base[1].x);
     server->protocol.gamemode.base[1].y = floorf(server->protocol.gamemode.base[1].y);
+    _send_intel_and_tents(server);
 }
 
-static void _init_arena(server_t* server)
+static const gamemode_ops_t gamemodes[] = {
+[GAME_MODE_CTF] = {.name            = "ctf",
+                   .init            = _init_ctf,
+                   .player_update   = handleTentAndIntel,
+                   .block_built     = moveIntelAndTentUp,
+                   .block_destroyed = move_intel_and_tent_down},
+[GAME_MODE_TC]  = {.name         = "tc",
+                   .init         = tc_init,
+                   .free         = tc_free,
+                   .tick         = tc_tick,
+                   .player_move  = tc_player_move,
+                   .player_leave = tc_player_leave},
+[GAME_MODE_BABEL] = {.name            = "babel",
+                     .init            = _init_babel,
+                     .player_update   = handleTentAndIntel,
+                     .block_built     = moveIntelAndTentUp,
+                     .block_destroyed = move_intel_and_tent_down},
+[GAME_MODE_ARENA] = {.name = "arena", .init = arena_init, .tick = arena_tick, .can_spawn = arena_can_spawn},
+};
+
+static const gamemode_ops_t gamemode_none = {.name = "none"};
+
+void gamemode_free(server_t* server)
 {
-    memcpy(server->gamemode_name, "arena", strlen("arena") + 1);
-    LOG_WARNING("GameMode not supported properly yet");
-    server->running = 0;
+    if (server->protocol.gamemode_ops != NULL && server->protocol.gamemode_ops->free != NULL) {
+        server->protocol.gamemode_ops->free(server);
+    }
+    server->protocol.gamemode_ops = NULL;
 }
 
 void gamemode_init(server_t* server, uint8_t gamemode)
 {
+    gamemode_free(server);
     server->protocol.current_gamemode = gamemode;
 
-    if (server->protocol.current_gamemode == GAME_MODE_CTF) {
-        _init_ctf(server);
-    } else if (server->protocol.current_gamemode == GAME_MODE_TC) {
-        _init_tc(server);
-    } else if (server->protocol.current_gamemode == GAME_MODE_BABEL) {
-        _init_babel(server);
-    } else if (server->protocol.current_gamemode == GAME_MODE_ARENA) {
-        _init_arena(server);
-    } else {
+    if (gamemode >= sizeof(gamemodes) / sizeof(gamemodes[0])) {
         LOG_ERROR("Unknown GameMode");
-        server->running = 0;
+        server->protocol.gamemode_ops = &gamemode_none;
+        server->running               = 0;
+        return;
     }
+    server->protocol.gamemode_ops = &gamemodes[gamemode];
+    snprintf(server->gamemode_name, sizeof(server->gamemode_name), "%s", gamemodes[gamemode].name);
+    gamemodes[gamemode].init(server);
 }
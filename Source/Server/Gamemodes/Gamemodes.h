@@ -3,8 +3,52 @@
 
 #include <Server/Structs/ServerStruct.h>
 
+/**
+ * @brief Set up the gamemode and install its hooks, gamemode_ops are only valid afterwards
+ */
 void    gamemode_init(server_t* server, uint8_t gamemode);
+void    gamemode_free(server_t* server);
 uint8_t gamemode_block_checks(server_t* server, int x, int y, int z);
 uint8_t grenadeGamemodeCheck(server_t* server, vector3f_t pos);
 
+static inline void gamemode_tick(server_t* server)
+{
+    if (server->protocol.gamemode_ops->tick != NULL) {
+        server->protocol.gamemode_ops->tick(server);
+    }
+}
+
+static inline void gamemode_player_move(server_t* server, player_t* player)
+{
+    if (server->protocol.gamemode_ops->player_move != NULL) {
+        server->protocol.gamemode_ops->player_move(server, player);
+    }
+}
+
+static inline void gamemode_player_leave(server_t* server, player_t* player)
+{
+    if (server->protocol.gamemode_ops->player_leave != NULL) {
+        server->protocol.gamemode_ops->player_leave(server, player);
+    }
+}
+
+static inline uint8_t gamemode_can_spawn(server_t* server, player_t* player)
+{
+    return server->protocol.gamemode_ops->can_spawn == NULL || server->protocol.gamemode_ops->can_spawn(server, player);
+}
+
+static inline void gamemode_block_built(server_t* server)
+{
+    if (server->protocol.gamemode_ops->block_built != NULL) {
+        server->protocol.gamemode_ops->block_built(server);
+    }
+}
+
+static inline void gamemode_block_destroyed(server_t* server)
+{
+    if (server->protocol.gamemode_ops->block_destroyed != NULL) {
+        server->protocol.gamemode_ops->block_destroyed(server);
+    }
+}
+
 #endif
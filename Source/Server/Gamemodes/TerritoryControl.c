@@ -0,0 +1,223 @@
+#include <Server/Gamemodes/TerritoryControl.h>
+#include <Server/Packets/Packets.h>
+#include <Server/Server.h>
+#include <Server/Structs/ServerStruct.h>
+#include <Util/Alloc.h>
+#include <Util/Enums.h>
+#include <Util/Log.h>
+#include <Util/Nanos.h>
+#include <Util/Uthash.h>
+#include <libmapvxl/libmapvxl.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void _build_grid(territory_control_t* tc)
+{
+    memset(tc->grid, 0, (size_t) tc->size_x * tc->size_y);
+    int radius = TC_CAPTURE_DISTANCE;
+    for (uint8_t i = 0; i < tc->count; ++i) {
+        int center_x = tc->territories[i].position.x;
+        int center_y = tc->territories[i].position.y;
+        for (int y = center_y - radius; y <= center_y + radius; ++y) {
+            for (int x = center_x - radius; x <= center_x + radius; ++x) {
+                if (x < 0 || y < 0 || x >= tc->size_x || y >= tc->size_y) {
+                    continue;
+                }
+                int distance = (x - center_x) * (x - center_x) + (y - center_y) * (y - center_y);
+                if (distance > radius * radius) {
+                    continue;
+                }
+                // Where two territories overlap the column goes to the closer one
+                uint8_t* cell = &tc->grid[y * tc->size_x + x];
+                if (*cell != 0) {
+                    territory_t* other = &tc->territories[*cell - 1];
+                    int other_distance = (x - (int) other->position.x) * (x - (int) other->position.x) +
+                                         (y - (int) other->position.y) * (y - (int) other->position.y);
+                    if (other_distance <= distance) {
+                        continue;
+                    }
+                }
+                *cell = i + 1;
+            }
+        }
+    }
+}
+
+void tc_init(server_t* server)
+{
+    territory_control_t* tc  = &server->protocol.gamemode.tc;
+    mapvxl_t*            map = &server->s_map.map;
+
+    server->protocol.gamemode.score[0]    = 0;
+    server->protocol.gamemode.score[1]    = 0;
+    server->protocol.gamemode.intel_flags = 0;
+
+    tc->size_x = map->size_x;
+    tc->size_y = map->size_y;
+    tc->grid   = (uint8_t*) spadesx_malloc((size_t) tc->size_x * tc->size_y);
+
+    // Territories on a line across the map, the half next to each spawn starts out owned by that team
+    uint8_t reversed = server->protocol.spawns[0].from.x + server->protocol.spawns[0].to.x >
+                       server->protocol.spawns[1].from.x + server->protocol.spawns[1].to.x;
+    tc->count        = TC_TERRITORY_COUNT;
+    for (uint8_t i = 0; i < tc->count; ++i) {
+        territory_t* territory = &tc->territories[i];
+        float        x         = (i + 0.5f) * map->size_x / tc->count;
+        float        y         = map->size_y / 4.0f + gen_rand(&server->rand) * map->size_y / 2.0f;
+        territory->position.x  = floorf(x);
+        territory->position.y  = floorf(y);
+        territory->position.z  = mapvxl_find_top_block(map, territory->position.x, territory->position.y);
+        territory->players[0]  = 0;
+        territory->players[1]  = 0;
+        territory->rate        = 0;
+
+        uint8_t side = reversed ? tc->count - 1 - i : i;
+        if (side * 2 + 1 < tc->count) {
+            territory->team     = TEAM_A;
+            territory->progress = 0;
+        } else if (side * 2 + 1 > tc->count) {
+            territory->team     = TEAM_B;
+            territory->progress = 1;
+        } else {
+            territory->team     = TC_TEAM_NEUTRAL;
+            territory->progress = 0.5f;
+        }
+    }
+    _build_grid(tc);
+    // Players that stay connected over a soft reset never get new state data
+    for (uint8_t i = 0; i < tc->count; ++i) {
+        send_move_object(server, i, tc->territories[i].team, tc->territories[i].position);
+    }
+
+    player_t *player, *tmp;
+    HASH_ITER(hh, server->players, player, tmp)
+    {
+        player->territory = 0;
+    }
+    tc->last_update = get_nanos();
+}
+
+void tc_free(server_t* server)
+{
+    territory_control_t* tc = &server->protocol.gamemode.tc;
+    free(tc->grid);
+    tc->grid = NULL;
+}
+
+static void _leave_territory(territory_control_t* tc, player_t* player)
+{
+    if (player->territory == 0) {
+        return;
+    }
+    territory_t* territory = &tc->territories[player->territory - 1];
+    if (territory->players[player->territory_team] > 0) {
+        territory->players[player->territory_team]--;
+    }
+    player->territory = 0;
+}
+
+void tc_player_move(server_t* server, player_t* player)
+{
+    territory_control_t* tc        = &server->protocol.gamemode.tc;
+    uint8_t              territory = 0;
+    if (player->state == STATE_READY && player->alive && (player->team == TEAM_A || player->team == TEAM_B)) {
+        int x = player->movement.position.x;
+        int y = player->movement.position.y;
+        if (x >= 0 && y >= 0 && x < tc->size_x && y < tc->size_y) {
+            territory = tc->grid[y * tc->size_x + x];
+        }
+        if (territory != 0 &&
+            fabsf(player->movement.position.z - tc->territories[territory - 1].position.z) > TC_CAPTURE_DISTANCE)
+        {
+            territory = 0;
+        }
+    }
+    if (territory == player->territory && (territory == 0 || player->territory_team == player->team)) {
+        return;
+    }
+    _leave_territory(tc, player);
+    if (territory != 0) {
+        player->territory      = territory;
+        player->territory_team = player->team;
+        tc->territories[territory - 1].players[player->team]++;
+    }
+}
+
+void tc_player_leave(server_t* server, player_t* player)
+{
+    _leave_territory(&server->protocol.gamemode.tc, player);
+}
+
+static void _send_progress(server_t* server, uint8_t index, territory_t* territory)
+{
+    uint8_t capturing_team;
+    if (territory->rate > 0) {
+        capturing_team = TEAM_B;
+    } else if (territory->rate < 0) {
+        capturing_team = TEAM_A;
+    } else {
+        capturing_team = (territory->team == TEAM_B) ? TEAM_A : TEAM_B;
+    }
+    float progress = (capturing_team == TEAM_B) ? territory->progress : 1 - territory->progress;
+    send_progress_bar(server, index, capturing_team, abs(territory->rate), progress);
+}
+
+// Returns 1 when the capture won the round and the gamemode was reset
+static uint8_t _capture(server_t* server, uint8_t index, uint8_t team)
+{
+    territory_control_t* tc = &server->protocol.gamemode.tc;
+    tc->territories[index].team = team;
+
+    uint8_t winning = 1;
+    for (uint8_t i = 0; i < tc->count; ++i) {
+        if (tc->territories[i].team != team) {
+            winning = 0;
+            break;
+        }
+    }
+    LOG_INFO("Team %s captured territory %hhu", server->protocol.name_team[team], index);
+    send_territory_capture(server, index, winning, team);
+    if (winning) {
+        server_round_reset(server);
+    }
+    return winning;
+}
+
+void tc_tick(server_t* server)
+{
+    territory_control_t* tc      = &server->protocol.gamemode.tc;
+    uint64_t             now     = get_nanos();
+    float                elapsed = (float) (now - tc->last_update) / NANO_IN_SECOND;
+    tc->last_update              = now;
+
+    for (uint8_t i = 0; i < tc->count; ++i) {
+        territory_t* territory = &tc->territories[i];
+        // Progress follows the rate clients were told about so their bars stay in step with the server
+        if (territory->rate != 0) {
+            territory->progress += territory->rate * TC_CAPTURE_RATE * elapsed;
+            if (territory->progress >= 1) {
+                territory->progress = 1;
+                if (territory->team != TEAM_B && _capture(server, i, TEAM_B)) {
+                    return;
+                }
+            } else if (territory->progress <= 0) {
+                territory->progress = 0;
+                if (territory->team != TEAM_A && _capture(server, i, TEAM_A)) {
+                    return;
+                }
+            }
+        }
+
+        int rate = territory->players[TEAM_B] - territory->players[TEAM_A];
+        if ((rate > 0 && territory->progress >= 1) || (rate < 0 && territory->progress <= 0)) {
+            rate = 0;
+        }
+        rate = rate > INT8_MAX ? INT8_MAX : (rate < -INT8_MAX ? -INT8_MAX : rate);
+        // Clients extrapolate the bar themselves, so only a change of rate is worth a packet
+        if (rate != territory->rate) {
+            territory->rate = rate;
+            _send_progress(server, i, territory);
+        }
+    }
+}
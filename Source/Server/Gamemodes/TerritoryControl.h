@@ -0,0 +1,27 @@
+#ifndef TERRITORYCONTROL_H
+#define TERRITORYCONTROL_H
+
+#include <Server/Structs/ServerStruct.h>
+
+#define TC_TERRITORY_COUNT  7
+#define TC_CAPTURE_DISTANCE 16
+#define TC_CAPTURE_RATE     0.05f // Progress per second for every player more of one team than the other
+
+/**
+ * @brief Spread the territories between the two spawns and index which columns belong to which one
+ */
+void tc_init(server_t* server);
+void tc_free(server_t* server);
+
+/**
+ * @brief Advance every capture and tell clients about captures and changes of rate
+ */
+void tc_tick(server_t* server);
+
+/**
+ * @brief Move the player between territories if they walked into another one, died or changed team
+ */
+void tc_player_move(server_t* server, player_t* player);
+void tc_player_leave(server_t* server, player_t* player);
+
+#endif
@@ -1,5 +1,5 @@
 #include <Server/Gamemodes/Gamemodes.h>
-#include <Server/IntelTent.h>
+#include <Server/Map.h>
 #include <Server/Nodes.h>
 #include <Server/Packets/Packets.h>
 #include <Server/Structs/ServerStruct.h>
@@ -63,6 +63,7 @@ void handle_grenade(server_t* server, player_t* player)
         uint32_t   counter = 0;
         DL_COUNT(player->grenade, elt, counter);
         if (counter == 0) {
+            server->players_by_id[player->id] = NULL;
             HASH_DELETE(hh, server->players, player);
             free(player);
             return;
@@ -73,6 +74,7 @@ void handle_grenade(server_t* server, player_t* player)
         if (grenade->sent) {
             physics_move_grenade(server, grenade, &server->physics);
             if ((get_nanos() - grenade->time_since_sent) / 1000000000.f >= grenade->fuse) {
+                EVENT_RUN(server, grenade_explode, player, grenade->position);
                 uint8_t allowToDestroy = 0;
                 if (grenadeGamemodeCheck(server, grenade->position)) {
                     send_block_action(server,
@@ -111,7 +113,7 @@ void handle_grenade(server_t* server, player_t* player)
                                 for (int Y = y_rounded; Y < y_rounded + 3; ++Y)
                                 { // I hate nested loops as any other C dev but here they do not cost that much perf
                                     if (valid_pos_3f(server, X, Y, z))
-                                        mapvxl_set_air(&server->s_map.map, X, Y, z);
+                                        map_set_air(server, player->id, X, Y, z);
                                 }
                             }
                         }
@@ -124,7 +126,7 @@ void handle_grenade(server_t* server, player_t* player)
 
                         for (int index = 0; index < 54; ++index) {
                             if (valid_pos_v3i(server, neigh[index])) {
-                                check_node(server, neigh[index]);
+                                check_node(server, player->id, neigh[index]);
                             }
                         }
                     }
@@ -132,7 +134,7 @@ void handle_grenade(server_t* server, player_t* player)
                 grenade->sent = 0;
                 DL_DELETE(player->grenade, grenade);
                 free(grenade);
-                move_intel_and_tent_down(server);
+                gamemode_block_destroyed(server);
             }
         }
     }
@@ -253,14 +253,7 @@ void handleTentAndIntel(server_t* server, player_t* player)
                     send_move_object(server, team, team, server->protocol.gamemode.intel[team]);
                 }
                 if (winning) {
-                    player_t *connected_player, *tmp;
-                    HASH_ITER(hh, server->players, connected_player, tmp)
-                    {
-                        if (connected_player->state != STATE_DISCONNECTED) {
-                            connected_player->state = STATE_STARTING_MAP;
-                        }
-                    }
-                    server_reset(server);
+                    server_round_reset(server);
                 }
             }
         }
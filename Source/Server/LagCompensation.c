@@ -0,0 +1,100 @@
+#include <Server/LagCompensation.h>
+#include <Server/Structs/ServerStruct.h>
+#include <Util/Enums.h>
+#include <Util/Types.h>
+#include <enet/enet.h>
+
+static inline vector3f_t _lerp(vector3f_t a, vector3f_t b, float t)
+{
+    vector3f_t result = {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t};
+    return result;
+}
+
+static inline const movement_snapshot_t* _snapshot(const movement_history_t* history, uint8_t age)
+{
+    return &history->snapshots[(history->head - 1 - age) & (MOVEMENT_HISTORY_SIZE - 1)];
+}
+
+void lag_compensation_reset(player_t* player)
+{
+    player->movement_history.head  = 0;
+    player->movement_history.count = 0;
+}
+
+void lag_compensation_record(player_t* player, uint64_t time)
+{
+    movement_history_t*  history  = &player->movement_history;
+    movement_snapshot_t* snapshot = &history->snapshots[history->head];
+
+    snapshot->time                = time;
+    snapshot->position            = player->movement.position;
+    snapshot->forward_orientation = player->movement.forward_orientation;
+
+    history->head = (history->head + 1) & (MOVEMENT_HISTORY_SIZE - 1);
+    if (history->count < MOVEMENT_HISTORY_SIZE) {
+        history->count++;
+    }
+}
+
+uint8_t lag_compensation_view_time(player_t* shooter, uint64_t time_now, uint64_t* view_time)
+{
+    // ENet starts every peer at its default round trip time until acknowledgements come back
+    uint32_t round_trip = shooter->peer->roundTripTime;
+    if (round_trip == ENET_PEER_DEFAULT_ROUND_TRIP_TIME) {
+        return 0;
+    }
+    // The shooter saw the world as it was roughly half a round trip ago
+    uint64_t rewind = (uint64_t) round_trip * NANO_IN_MILLI / 2;
+    if (rewind > LAG_COMPENSATION_MAX_REWIND || rewind > time_now) {
+        return 0;
+    }
+    *view_time = time_now - rewind;
+    return 1;
+}
+
+float lag_compensation_tolerance(player_t* shooter)
+{
+    // The view time is off by about half the round trip variance, the victim may have moved that long at full speed
+    uint64_t jitter = (uint64_t) shooter->peer->roundTripTimeVariance * NANO_IN_MILLI / 2;
+    if (jitter > LAG_COMPENSATION_MAX_REWIND) {
+        jitter = LAG_COMPENSATION_MAX_REWIND;
+    }
+    return LAG_COMPENSATION_BASE_TOLERANCE + LAG_COMPENSATION_MAX_SPEED * (float) jitter / (float) NANO_IN_SECOND;
+}
+
+uint8_t lag_compensation_rewind(player_t* player, uint64_t time, vector3f_t* position, vector3f_t* orientation)
+{
+    const movement_history_t* history = &player->movement_history;
+    if (history->count == 0) {
+        return 0;
+    }
+
+    const movement_snapshot_t* newer = _snapshot(history, 0);
+    if (time >= newer->time) {
+        *position = newer->position;
+        if (orientation != NULL) {
+            *orientation = newer->forward_orientation;
+        }
+        return 1;
+    }
+
+    for (uint8_t age = 1; age < history->count; ++age) {
+        const movement_snapshot_t* older = _snapshot(history, age);
+        if (older->time <= time) {
+            float t   = (float) (time - older->time) / (float) (newer->time - older->time);
+            *position = _lerp(older->position, newer->position, t);
+            if (orientation != NULL) {
+                *orientation = _lerp(older->forward_orientation, newer->forward_orientation, t);
+            }
+            return 1;
+        }
+        newer = older;
+    }
+
+    // Older than anything we have, the oldest snapshot is the best guess
+    *position = newer->position;
+    if (orientation != NULL) {
+        *orientation = newer->forward_orientation;
+    }
+    return 1;
+}
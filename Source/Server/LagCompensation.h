@@ -0,0 +1,23 @@
+#ifndef LAGCOMPENSATION_H
+#define LAGCOMPENSATION_H
+
+#include <Server/Structs/ServerStruct.h>
+#include <Util/Enums.h>
+
+// Never rewind further than this, no matter how bad the shooter's connection is
+#define LAG_COMPENSATION_MAX_REWIND (NANO_IN_MILLI * 500)
+// Hit tolerance without any jitter, the same the server used before rewinding
+#define LAG_COMPENSATION_BASE_TOLERANCE 5.f
+// Blocks per second, a bit above the fastest a player gets on foot. Bounds how far the victim can be off the rewound
+// position when the view time is off by the jitter
+#define LAG_COMPENSATION_MAX_SPEED 10.f
+
+void lag_compensation_reset(player_t* player);
+void lag_compensation_record(player_t* player, uint64_t time);
+// Returns 0 while ENet has no round trip sample of the shooter yet or it is too large to rewind that far
+uint8_t lag_compensation_view_time(player_t* shooter, uint64_t time_now, uint64_t* view_time);
+// Hit tolerance for a shot validated at the view time, grows with the jitter of the shooter's round trip time
+float   lag_compensation_tolerance(player_t* shooter);
+uint8_t lag_compensation_rewind(player_t* player, uint64_t time, vector3f_t* position, vector3f_t* orientation);
+
+#endif
@@ -1,4 +1,5 @@
 // Copyright DarkNeutrino 2021
+#include <Server/Map.h>
 #include <Server/Structs/ServerStruct.h>
 #include <Util/Compress.h>
 #include <Util/DataStream.h>
@@ -11,14 +12,321 @@
 #include <libmapvxl/libmapvxl.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+static inline uint32_t _column_count(mapvxl_t* map)
+{
+    return (uint32_t) map->size_x * map->size_y;
+}
+
+// Copy a column the first time it is written to, everything else of the snapshot is shared with the live map
+static void _save_column(map_t* s_map, int x, int y)
+{
+    map_snapshot_t* snapshot = &s_map->snapshot;
+    mapvxl_t*       map      = &s_map->map;
+    if (snapshot->slots == NULL || x < 0 || y < 0 || x >= map->size_x || y >= map->size_y) {
+        return;
+    }
+    uint32_t column = (uint32_t) y * map->size_x + x;
+    if (snapshot->slots[column] != 0) {
+        return;
+    }
+
+    if (snapshot->count == snapshot->capacity) {
+        uint32_t  capacity = snapshot->capacity == 0 ? 256 : snapshot->capacity * 2;
+        uint32_t* columns  = (uint32_t*) realloc(snapshot->columns, capacity * sizeof(uint32_t));
+        uint32_t* colors   = (uint32_t*) realloc(snapshot->colors, (size_t) capacity * map->size_z * sizeof(uint32_t));
+        uint8_t*  solid    = (uint8_t*) realloc(snapshot->solid, (size_t) capacity * map->size_z);
+        if (columns != NULL) {
+            snapshot->columns = columns;
+        }
+        if (colors != NULL) {
+            snapshot->colors = colors;
+        }
+        if (solid != NULL) {
+            snapshot->solid = solid;
+        }
+        if (columns == NULL || colors == NULL || solid == NULL) {
+            LOG_ERROR("Out of memory while saving map column, soft resets are disabled until the next map load");
+            snapshot->broken = 1;
+            return;
+        }
+        snapshot->capacity = capacity;
+    }
+
+    uint32_t  slot   = snapshot->count++;
+    uint32_t* colors = snapshot->colors + (size_t) slot * map->size_z;
+    uint8_t*  solid  = snapshot->solid + (size_t) slot * map->size_z;
+    for (int z = 0; z < map->size_z; ++z) {
+        solid[z]  = mapvxl_is_solid(map, x, y, z);
+        colors[z] = solid[z] ? mapvxl_get_color(map, x, y, z) : 0;
+    }
+    snapshot->columns[slot] = column;
+    snapshot->slots[column] = slot + 1;
+}
+
+// Every change of the live map ends up here, so listeners see edits, undos and restores alike
+static void _write(server_t* server, uint8_t editor, int x, int y, int z, uint8_t solid, uint32_t color)
+{
+    vector3i_t position = {x, y, z};
+    EVENT_RUN(server, block_change, editor, position, solid, color);
+    if (solid) {
+        mapvxl_set_color(&server->s_map.map, x, y, z, color);
+    } else {
+        mapvxl_set_air(&server->s_map.map, x, y, z);
+    }
+}
+
+// Returns 0 when the voxel is outside of the map or would not change
+static uint8_t _journal(server_t* server, uint8_t editor, int x, int y, int z, uint8_t solid, uint32_t color)
+{
+    map_journal_t* journal = &server->s_map.journal;
+    mapvxl_t*      map     = &server->s_map.map;
+    if (x < 0 || y < 0 || z < 0 || x >= map->size_x || y >= map->size_y || z >= map->size_z) {
+        return 0;
+    }
+    uint8_t  was_solid = mapvxl_is_solid(map, x, y, z);
+    uint32_t old_color = was_solid ? mapvxl_get_color(map, x, y, z) : 0;
+    if (was_solid == solid && old_color == color) {
+        return 0;
+    }
+    if (journal->edits == NULL) {
+        journal->edits = (map_edit_t*) spadesx_calloc(MAP_JOURNAL_SIZE, sizeof(map_edit_t));
+    }
+    map_edit_t* edit = &journal->edits[journal->head++ & (MAP_JOURNAL_SIZE - 1)];
+    edit->x          = x;
+    edit->y          = y;
+    edit->z          = z;
+    edit->editor     = editor;
+    edit->flags      = (was_solid ? MAP_EDIT_WAS_SOLID : 0) | (solid ? MAP_EDIT_IS_SOLID : 0);
+    edit->old_color  = old_color;
+    edit->new_color  = color;
+    edit->tick       = server->global_timers.ticks;
+    return 1;
+}
+
+static inline void _write_voxel(server_t* server, uint8_t editor, int x, int y, int z, uint8_t solid, uint32_t color)
+{
+    if (_journal(server, editor, x, y, z, solid, color)) {
+        _write(server, editor, x, y, z, solid, color);
+    }
+}
+
+void map_set_color(server_t* server, uint8_t editor, int x, int y, int z, uint32_t color)
+{
+    _save_column(&server->s_map, x, y);
+    _write_voxel(server, editor, x, y, z, 1, color);
+}
+
+void map_set_air(server_t* server, uint8_t editor, int x, int y, int z)
+{
+    _save_column(&server->s_map, x, y);
+    _write_voxel(server, editor, x, y, z, 0, 0);
+}
+
+static int _compare_columns(const void* a, const void* b)
+{
+    const vector3i_t* first  = (const vector3i_t*) a;
+    const vector3i_t* second = (const vector3i_t*) b;
+    if (first->y != second->y) {
+        return first->y < second->y ? -1 : 1;
+    }
+    if (first->x != second->x) {
+        return first->x < second->x ? -1 : 1;
+    }
+    return (first->z > second->z) - (first->z < second->z);
+}
+
+void map_set_color_many(server_t* server, uint8_t editor, vector3i_t* positions, uint32_t count, uint32_t color)
+{
+    // Column by column, so every column is saved for the snapshot once instead of once per voxel. Voxels are still
+    // journaled and written one by one, libmapvxl has no call that writes a whole column span
+    qsort(positions, count, sizeof(*positions), _compare_columns);
+    for (uint32_t i = 0; i < count; ++i) {
+        vector3i_t* position = &positions[i];
+        if (i == 0 || position->x != positions[i - 1].x || position->y != positions[i - 1].y) {
+            _save_column(&server->s_map, position->x, position->y);
+        }
+        _write_voxel(server, editor, position->x, position->y, position->z, 1, color);
+    }
+}
+
+int64_t map_undo(server_t* server, uint8_t editor, uint32_t max_edits, map_restore_fn_t callback, void* arg)
+{
+    map_journal_t* journal = &server->s_map.journal;
+    mapvxl_t*      map     = &server->s_map.map;
+    if (journal->edits == NULL) {
+        return 0;
+    }
+
+    // Newest first, so a voxel edited several times ends up in the state before the first edit
+    uint32_t available = journal->head < MAP_JOURNAL_SIZE ? journal->head : MAP_JOURNAL_SIZE;
+    uint32_t matched   = 0;
+    int64_t  restored  = 0;
+    for (uint32_t i = 1; i <= available && matched < max_edits; ++i) {
+        map_edit_t* edit = &journal->edits[(journal->head - i) & (MAP_JOURNAL_SIZE - 1)];
+        if (edit->editor != editor || (edit->flags & MAP_EDIT_UNDONE) != 0) {
+            continue;
+        }
+        matched++;
+        edit->flags |= MAP_EDIT_UNDONE;
+
+        // Somebody else changed the voxel since, their edit wins
+        uint8_t is_solid = (edit->flags & MAP_EDIT_IS_SOLID) != 0;
+        if (mapvxl_is_solid(map, edit->x, edit->y, edit->z) != is_solid ||
+            (is_solid && mapvxl_get_color(map, edit->x, edit->y, edit->z) != edit->new_color))
+        {
+            continue;
+        }
+
+        uint8_t was_solid = (edit->flags & MAP_EDIT_WAS_SOLID) != 0;
+        _save_column(&server->s_map, edit->x, edit->y);
+        _write(server, MAP_EDITOR_SERVER, edit->x, edit->y, edit->z, was_solid, edit->old_color);
+        vector3i_t position = {edit->x, edit->y, edit->z};
+        callback(server, arg, position, was_solid, edit->old_color);
+        restored++;
+    }
+    return restored;
+}
+
+void map_journal_forget(server_t* server, uint8_t editor)
+{
+    map_journal_t* journal = &server->s_map.journal;
+    if (journal->edits == NULL) {
+        return;
+    }
+    uint32_t available = journal->head < MAP_JOURNAL_SIZE ? journal->head : MAP_JOURNAL_SIZE;
+    for (uint32_t i = 0; i < available; ++i) {
+        if (journal->edits[i].editor == editor) {
+            journal->edits[i].editor = MAP_EDITOR_SERVER;
+        }
+    }
+}
+
+static void _drop_snapshot(map_t* s_map)
+{
+    map_snapshot_t* snapshot = &s_map->snapshot;
+    s_map->journal.head      = 0;
+    free(snapshot->slots);
+    free(snapshot->columns);
+    free(snapshot->colors);
+    free(snapshot->solid);
+    memset(snapshot, 0, sizeof(*snapshot));
+}
+
+// Forget the saved columns, the live map becomes the pristine state
+static void _clear_snapshot(map_t* s_map)
+{
+    map_snapshot_t* snapshot = &s_map->snapshot;
+    for (uint32_t slot = 0; slot < snapshot->count; ++slot) {
+        snapshot->slots[snapshot->columns[slot]] = 0;
+    }
+    snapshot->count  = 0;
+    snapshot->broken = 0;
+    // Journaled positions mean nothing once the map they were made on is gone
+    s_map->journal.head = 0;
+}
+
+void map_snapshot(server_t* server)
+{
+    map_t*          s_map    = &server->s_map;
+    map_snapshot_t* snapshot = &s_map->snapshot;
+    if (s_map->map.blocks == NULL) {
+        _drop_snapshot(s_map);
+        return;
+    }
+    if (snapshot->slots != NULL && snapshot->size_x == s_map->map.size_x && snapshot->size_y == s_map->map.size_y &&
+        snapshot->size_z == s_map->map.size_z)
+    {
+        _clear_snapshot(s_map);
+        return;
+    }
+    _drop_snapshot(s_map);
+    snapshot->slots  = (uint32_t*) spadesx_calloc(_column_count(&s_map->map), sizeof(uint32_t));
+    snapshot->size_x = s_map->map.size_x;
+    snapshot->size_y = s_map->map.size_y;
+    snapshot->size_z = s_map->map.size_z;
+}
+
+static inline uint8_t _voxel_differs(mapvxl_t* map, uint8_t solid, uint32_t color, int x, int y, int z)
+{
+    if (solid != mapvxl_is_solid(map, x, y, z)) {
+        return 1;
+    }
+    return solid && color != mapvxl_get_color(map, x, y, z);
+}
+
+// Put back either the solid or the empty voxels of every saved column
+static void _restore_pass(server_t* server, uint8_t solid, map_restore_fn_t callback, void* arg)
+{
+    map_snapshot_t* snapshot = &server->s_map.snapshot;
+    mapvxl_t*       map      = &server->s_map.map;
+    for (uint32_t slot = 0; slot < snapshot->count; ++slot) {
+        uint32_t* colors = snapshot->colors + (size_t) slot * map->size_z;
+        uint8_t*  saved  = snapshot->solid + (size_t) slot * map->size_z;
+        int       x      = snapshot->columns[slot] % map->size_x;
+        int       y      = snapshot->columns[slot] / map->size_x;
+        for (int z = 0; z < map->size_z; ++z) {
+            if (saved[z] != solid || !_voxel_differs(map, saved[z], colors[z], x, y, z)) {
+                continue;
+            }
+            _write(server, MAP_EDITOR_SERVER, x, y, z, solid, colors[z]);
+            if (callback != NULL) {
+                vector3i_t position = {x, y, z};
+                callback(server, arg, position, solid, colors[z]);
+            }
+        }
+    }
+}
+
+int64_t map_restore(server_t* server, uint32_t max_changes, map_restore_fn_t callback, void* arg)
+{
+    map_snapshot_t* snapshot = &server->s_map.snapshot;
+    mapvxl_t*       map      = &server->s_map.map;
+    if (snapshot->slots == NULL || snapshot->broken) {
+        return -1;
+    }
+
+    // Count first so nothing is touched when the caller would rather reload the whole map
+    uint32_t changes = 0;
+    for (uint32_t slot = 0; slot < snapshot->count; ++slot) {
+        uint32_t* colors = snapshot->colors + (size_t) slot * map->size_z;
+        uint8_t*  solid  = snapshot->solid + (size_t) slot * map->size_z;
+        int       x      = snapshot->columns[slot] % map->size_x;
+        int       y      = snapshot->columns[slot] / map->size_x;
+        for (int z = 0; z < map->size_z; ++z) {
+            if (_voxel_differs(map, solid[z], colors[z], x, y, z) && ++changes > max_changes) {
+                return -1;
+            }
+        }
+    }
+
+    _restore_pass(server, 1, callback, arg);
+    _restore_pass(server, 0, callback, arg);
+    _clear_snapshot(&server->s_map);
+    return changes;
+}
 
 uint8_t map_load(server_t* server, const char* path, int map_size[3])
 {
+    // Same file again: undo the edits in memory instead of reading and decoding the whole VXL
+    map_snapshot_t* snapshot = &server->s_map.snapshot;
+    if (server->s_map.map.blocks != NULL && strcmp(server->s_map.path, path) == 0 && snapshot->size_x == map_size[0] &&
+        snapshot->size_y == map_size[1] && snapshot->size_z == map_size[2])
+    {
+        int64_t changes = map_restore(server, UINT32_MAX, NULL, NULL);
+        if (changes >= 0) {
+            LOG_STATUS("Restored %lld blocks of map", (long long) changes);
+            return 1;
+        }
+    }
+
     LOG_STATUS("Loading map");
 
     if (server->s_map.map.blocks != NULL) {
         mapvxl_free(&server->s_map.map);
     }
+    server->s_map.path[0] = '\0';
 
     FILE* file = fopen(path, "rb");
     if (!file) {
@@ -60,5 +368,69 @@ uint8_t map_load(server_t* server, const char* path, int map_size[3])
     LOG_STATUS("Finished transforming map");
 
     free(buffer);
+    snprintf(server->s_map.path, sizeof(server->s_map.path), "%s", path);
     return 1;
 }
+
+void map_protection_clear(server_t* server)
+{
+    free(server->s_map.protection.columns);
+    server->s_map.protection.columns = NULL;
+}
+
+void map_protect_box(server_t* server, vector3i_t from, vector3i_t to)
+{
+    map_protection_t* protection = &server->s_map.protection;
+    mapvxl_t*         map        = &server->s_map.map;
+    if (protection->columns == NULL) {
+        protection->size_x  = map->size_x;
+        protection->size_y  = map->size_y;
+        protection->columns = (uint64_t*) spadesx_calloc(_column_count(map), sizeof(uint64_t));
+    }
+    from.x = from.x < 0 ? 0 : from.x;
+    from.y = from.y < 0 ? 0 : from.y;
+    from.z = from.z < 0 ? 0 : from.z;
+    to.x   = to.x >= protection->size_x ? protection->size_x - 1 : to.x;
+    to.y   = to.y >= protection->size_y ? protection->size_y - 1 : to.y;
+    if (to.z > 63) {
+        LOG_WARNING("Only the lowest 64 levels of the map can be protected");
+        to.z = 63;
+    }
+    if (from.z > to.z) {
+        return;
+    }
+    uint64_t mask = (UINT64_MAX >> (63 - to.z)) & (UINT64_MAX << from.z);
+    for (int y = from.y; y <= to.y; ++y) {
+        for (int x = from.x; x <= to.x; ++x) {
+            protection->columns[y * protection->size_x + x] |= mask;
+        }
+    }
+}
+
+uint8_t map_is_protected(server_t* server, int x, int y, int z_from, int z_to)
+{
+    map_protection_t* protection = &server->s_map.protection;
+    if (protection->columns == NULL || x < 0 || y < 0 || x >= protection->size_x || y >= protection->size_y) {
+        return 0;
+    }
+    z_from = z_from < 0 ? 0 : z_from;
+    z_to   = z_to > 63 ? 63 : z_to;
+    if (z_from > z_to) {
+        return 0;
+    }
+    uint64_t mask = (UINT64_MAX >> (63 - z_to)) & (UINT64_MAX << z_from);
+    return (protection->columns[y * protection->size_x + x] & mask) != 0;
+}
+
+void map_free(server_t* server)
+{
+    map_protection_clear(server);
+    _drop_snapshot(&server->s_map);
+    free(server->s_map.journal.edits);
+    server->s_map.journal.edits = NULL;
+    if (server->s_map.map.blocks != NULL) {
+        mapvxl_free(&server->s_map.map);
+        server->s_map.map.blocks = NULL;
+    }
+    server->s_map.path[0] = '\0';
+}
@@ -6,6 +6,76 @@
 #include <Util/Queue.h>
 #include <Util/Types.h>
 
+/**
+ * @brief Called for every voxel map_restore puts back, solid voxels come with their pristine colour
+ */
+typedef void (*map_restore_fn_t)(server_t* server, void* arg, vector3i_t position, uint8_t solid, uint32_t color);
+
+/**
+ * @brief Load a VXL map. Loading the file that is already loaded only restores the edited columns
+ */
 uint8_t map_load(server_t* server, const char* path, int map_size[3]);
+void    map_free(server_t* server);
+
+/**
+ * @brief Edit the live map. Every write goes through these so soft resets know which columns changed
+ *
+ * @param editor Player id the edit is journaled under, MAP_EDITOR_SERVER for edits nobody is to blame for
+ */
+void map_set_color(server_t* server, uint8_t editor, int x, int y, int z, uint32_t color);
+void map_set_air(server_t* server, uint8_t editor, int x, int y, int z);
+
+/**
+ * @brief Paint many voxels with one colour, grouped by column
+ *
+ * @param positions Voxels to paint. The array is sorted by column in place, callers must not rely on its order
+ *                  afterwards
+ */
+void map_set_color_many(server_t* server, uint8_t editor, vector3i_t* positions, uint32_t count, uint32_t color);
+
+/**
+ * @brief Revert the latest edits of one player that are still in the journal
+ *
+ * Voxels changed again by somebody else since are left alone. Reverted voxels are reported to the callback.
+ *
+ * @param max_edits How many of the player's journaled edits to go back
+ * @return Number of voxels that were reverted
+ */
+int64_t map_undo(server_t* server, uint8_t editor, uint32_t max_edits, map_restore_fn_t callback, void* arg);
+
+/**
+ * @brief Hand the journaled edits of a player id over to MAP_EDITOR_SERVER, called when the id goes to a new player
+ *
+ * Until then /undo of the id still reaches the edits of the player that left.
+ */
+void map_journal_forget(server_t* server, uint8_t editor);
+
+/**
+ * @brief Remember the current map as the pristine state that map_restore goes back to
+ *
+ * Nothing is copied here, columns are saved copy-on-write the first time they are edited afterwards.
+ */
+void map_snapshot(server_t* server);
+
+/**
+ * @brief Put every voxel edited since the last snapshot back to its pristine state
+ *
+ * Restored solid voxels are reported before removed ones, so structures of the pristine map never lose their support
+ * on clients replaying the changes in order. Nothing is touched when more than max_changes voxels differ.
+ *
+ * @return Number of restored voxels, or -1 when there is no snapshot or the diff is larger than max_changes
+ */
+int64_t map_restore(server_t* server, uint32_t max_changes, map_restore_fn_t callback, void* arg);
+
+/**
+ * @brief Protect every voxel between two corners, both inclusive, against players. Only z 0 to 63 can be protected
+ */
+void map_protect_box(server_t* server, vector3i_t from, vector3i_t to);
+void map_protection_clear(server_t* server);
+
+/**
+ * @brief Whether any voxel of column x, y between z_from and z_to (inclusive) is protected
+ */
+uint8_t map_is_protected(server_t* server, int x, int y, int z_from, int z_to);
 
 #endif
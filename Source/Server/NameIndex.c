@@ -0,0 +1,157 @@
+#include <Server/NameIndex.h>
+#include <Server/Structs/ServerStruct.h>
+#include <Util/Log.h>
+#include <ctype.h>
+#include <string.h>
+
+// Matched anywhere in the lowercased name
+static const char* unwanted_names[] = {"igger", "1gger", "igg3r", "1gg3r"};
+
+static uint32_t _name_hash(const char* folded)
+{
+    uint32_t hash = 2166136261u;
+    for (; *folded != '\0'; ++folded) {
+        hash ^= (uint8_t) *folded;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+uint8_t name_fold(char* dst, const char* name, size_t length)
+{
+    uint8_t readable = 1;
+    size_t  i        = 0;
+    for (; i < length && i < PLAYER_NAME_STRLEN && name[i] != '\0'; ++i) {
+        if (isgraph((unsigned char) name[i]) == 0 && name[i] != ' ') {
+            readable = 0;
+        }
+        dst[i] = tolower((unsigned char) name[i]);
+    }
+    dst[i] = '\0';
+    return readable;
+}
+
+void name_filter_init(server_t* server)
+{
+    name_index_t* index  = &server->names;
+    uint8_t       states = 1;
+    uint8_t       fail[NAME_FILTER_STATES];
+    uint8_t       queue[NAME_FILTER_STATES];
+
+    memset(index->filter, 0, sizeof(index->filter));
+    memset(index->filter_match, 0, sizeof(index->filter_match));
+
+    // Build the trie, 0 doubles as "no child" since nothing ever goes back to the root
+    for (size_t i = 0; i < sizeof(unwanted_names) / sizeof(unwanted_names[0]); ++i) {
+        uint8_t     state = 0;
+        const char* c     = unwanted_names[i];
+        for (; *c != '\0'; ++c) {
+            uint8_t* next = &index->filter[state][(uint8_t) *c];
+            if (*next == 0) {
+                if (states == NAME_FILTER_STATES) {
+                    LOG_ERROR("Unwanted name filter is full, skipping %s", unwanted_names[i]);
+                    break;
+                }
+                *next = states++;
+            }
+            state = *next;
+        }
+        if (*c == '\0') {
+            index->filter_match[state] = 1;
+        }
+    }
+
+    // Breadth first, so the failure state of every node is complete before its children are visited
+    uint8_t head = 0, tail = 0;
+    for (uint32_t c = 0; c < 256; ++c) {
+        uint8_t child = index->filter[0][c];
+        if (child != 0) {
+            fail[child]   = 0;
+            queue[tail++] = child;
+        }
+    }
+    while (head < tail) {
+        uint8_t state = queue[head++];
+        index->filter_match[state] |= index->filter_match[fail[state]];
+        for (uint32_t c = 0; c < 256; ++c) {
+            uint8_t child = index->filter[state][c];
+            if (child != 0) {
+                fail[child]   = index->filter[fail[state]][c];
+                queue[tail++] = child;
+            } else {
+                index->filter[state][c] = index->filter[fail[state]][c];
+            }
+        }
+    }
+}
+
+uint8_t name_filter_match(server_t* server, const char* folded)
+{
+    name_index_t* index = &server->names;
+    uint8_t       state = 0;
+    for (; *folded != '\0'; ++folded) {
+        state = index->filter[state][(uint8_t) *folded];
+        if (index->filter_match[state]) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void name_index_remove(server_t* server, player_t* player)
+{
+    name_index_t* index = &server->names;
+    uint32_t      hole  = 0;
+    while (hole < NAME_INDEX_SIZE && index->slots[hole] != player->id + 1) {
+        hole++;
+    }
+    if (hole == NAME_INDEX_SIZE) {
+        return;
+    }
+
+    // Shift the rest of the probe run back so lookups never stop early on the freed slot
+    for (uint32_t slot = (hole + 1) & (NAME_INDEX_SIZE - 1); index->slots[slot] != 0;
+         slot          = (slot + 1) & (NAME_INDEX_SIZE - 1))
+    {
+        player_t* moved = server->players_by_id[index->slots[slot] - 1];
+        uint32_t  home  = _name_hash(moved->folded_name) & (NAME_INDEX_SIZE - 1);
+        if (((slot - home) & (NAME_INDEX_SIZE - 1)) >= ((slot - hole) & (NAME_INDEX_SIZE - 1))) {
+            index->slots[hole] = index->slots[slot];
+            hole               = slot;
+        }
+    }
+    index->slots[hole] = 0;
+}
+
+void name_index_add(server_t* server, player_t* player)
+{
+    name_index_t* index = &server->names;
+    name_index_remove(server, player);
+    name_fold(player->folded_name, player->name, PLAYER_NAME_STRLEN);
+
+    uint32_t slot = _name_hash(player->folded_name) & (NAME_INDEX_SIZE - 1);
+    while (index->slots[slot] != 0) {
+        slot = (slot + 1) & (NAME_INDEX_SIZE - 1);
+    }
+    index->slots[slot] = player->id + 1;
+}
+
+player_t* name_index_find(server_t* server, const char* name, size_t length)
+{
+    name_index_t* index = &server->names;
+    char          folded[PLAYER_NAME_STRLEN + 1];
+    if (length > PLAYER_NAME_STRLEN) {
+        return NULL;
+    }
+    name_fold(folded, name, length);
+
+    uint32_t slot = _name_hash(folded) & (NAME_INDEX_SIZE - 1);
+    for (uint32_t probes = 0; probes < NAME_INDEX_SIZE && index->slots[slot] != 0; ++probes) {
+        player_t* player = server->players_by_id[index->slots[slot] - 1];
+        if (strcmp(player->folded_name, folded) == 0) {
+            return player;
+        }
+        slot = (slot + 1) & (NAME_INDEX_SIZE - 1);
+    }
+    return NULL;
+}
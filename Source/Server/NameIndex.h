@@ -0,0 +1,41 @@
+#ifndef NAMEINDEX_H
+#define NAMEINDEX_H
+
+#include <Server/Structs/ServerStruct.h>
+#include <stddef.h>
+
+/**
+ * @brief Lowercase a name of at most length characters into dst, which must hold PLAYER_NAME_STRLEN + 1 bytes
+ *
+ * @return 1 if every character was printable, 0 otherwise
+ */
+uint8_t name_fold(char* dst, const char* name, size_t length);
+
+/**
+ * @brief Compile the unwanted name filter, called once on startup
+ */
+void name_filter_init(server_t* server);
+
+/**
+ * @brief Check a folded name against the unwanted words in a single pass
+ *
+ * @return 1 if the name contains one of them
+ */
+uint8_t name_filter_match(server_t* server, const char* folded);
+
+/**
+ * @brief Index the player under their current name, replacing the entry for their previous name
+ */
+void name_index_add(server_t* server, player_t* player);
+
+void name_index_remove(server_t* server, player_t* player);
+
+/**
+ * @brief Find a player by name, ignoring case
+ *
+ * @param length Characters of name to use, names are not required to be null terminated
+ * @return The player or NULL
+ */
+player_t* name_index_find(server_t* server, const char* name, size_t length);
+
+#endif
@@ -1,3 +1,4 @@
+#include <Server/Map.h>
 #include <Server/Structs/ServerStruct.h>
 #include <Util/Checks/PositionChecks.h>
 #include <Util/Log.h>
@@ -48,7 +49,7 @@ static inline void addNode(server_t* server, int x, int y, int z)
     }
 }
 
-uint8_t check_node(server_t* server, vector3i_t position)
+uint8_t check_node(server_t* server, uint8_t editor, vector3i_t position)
 {
     if (valid_pos_v3i(server, position) && mapvxl_is_solid(&server->s_map.map, position.x, position.y, position.z) == 0)
     {
@@ -119,7 +120,7 @@ uint8_t check_node(server_t* server, vector3i_t position)
     {
         vector3i_t block = {Node->pos.x, Node->pos.y, Node->pos.z};
         if (valid_pos_v3i(server, block)) {
-            mapvxl_set_air(&server->s_map.map, Node->pos.x, Node->pos.y, Node->pos.z);
+            map_set_air(server, editor, Node->pos.x, Node->pos.y, Node->pos.z);
         }
         HASH_DEL(visitedMap, Node);
         free(Node);
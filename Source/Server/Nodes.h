@@ -5,6 +5,6 @@
 #include <Server/Structs/ServerStruct.h>
 
 vector3i_t* get_neighbours(vector3i_t pos);
-uint8_t     check_node(server_t* server, vector3i_t position);
+uint8_t     check_node(server_t* server, uint8_t editor, vector3i_t position);
 
 #endif
@@ -1,7 +1,9 @@
 #include <Server/Block.h>
+#include <Server/Egress.h>
 #include <Server/Gamemodes/Gamemodes.h>
-#include <Server/IntelTent.h>
 #include <Server/Nodes.h>
+#include <Server/Packets/Schema.h>
+#include <Server/Player.h>
 #include <Server/Server.h>
 #include <Server/Staff.h>
 #include <Server/Structs/CommandStruct.h>
@@ -22,20 +24,16 @@ void send_block_action(server_t* server, player_t* player, uint8_t actionType, i
     if (server->protocol.num_players == 0) {
         return;
     }
-    ENetPacket* packet = enet_packet_create(NULL, 15, ENET_PACKET_FLAG_RELIABLE);
-    stream_t    stream = {packet->data, packet->dataLength, 0};
-    stream_write_u8(&stream, PACKET_TYPE_BLOCK_ACTION);
-    stream_write_u8(&stream, player->id);
-    stream_write_u8(&stream, actionType);
-    stream_write_u32(&stream, X);
-    stream_write_u32(&stream, Y);
-    stream_write_u32(&stream, Z);
+    // Clients paint the block with the last colour they got for this player, it must not lag behind
+    flush_pending_broadcasts(server, player);
+    packet_block_action_t block_action = {player->id, actionType, {X, Y, Z}};
+    ENetPacket*           packet       = packet_block_action_create(&block_action, ENET_PACKET_FLAG_RELIABLE);
     uint8_t   sent = 0;
     player_t *check, *tmp;
     HASH_ITER(hh, server->players, check, tmp)
     {
         if (is_past_state_data(check)) {
-            if (enet_peer_send(check->peer, 0, packet) == 0) {
+            if (egress_send(server, check, packet, EGRESS_BLOCK) == 0) {
                 sent = 1;
             }
         } else if (player->state == STATE_STARTING_MAP || player->state == STATE_LOADING_CHUNKS) {
@@ -64,16 +62,10 @@ void send_block_action_to_player(server_t* server,
     if (server->protocol.num_players == 0) {
         return;
     }
-    ENetPacket* packet = enet_packet_create(NULL, 15, ENET_PACKET_FLAG_RELIABLE);
-    stream_t    stream = {packet->data, packet->dataLength, 0};
-    stream_write_u8(&stream, PACKET_TYPE_BLOCK_ACTION);
-    stream_write_u8(&stream, player->id);
-    stream_write_u8(&stream, actionType);
-    stream_write_u32(&stream, X);
-    stream_write_u32(&stream, Y);
-    stream_write_u32(&stream, Z);
+    packet_block_action_t block_action = {player->id, actionType, {X, Y, Z}};
+    ENetPacket*           packet       = packet_block_action_create(&block_action, ENET_PACKET_FLAG_RELIABLE);
     uint8_t sent = 0;
-    if (enet_peer_send(receiver->peer, 0, packet) == 0) {
+    if (egress_send(server, receiver, packet, EGRESS_BLOCK) == 0) {
         sent = 1;
     }
     if (sent == 0) {
@@ -81,19 +73,63 @@ void send_block_action_to_player(server_t* server,
     }
 }
 
+uint8_t block_painter_init(server_t* server, block_painter_t* painter)
+{
+    painter->player_id = 0;
+    painter->painting  = 0;
+    painter->color     = 0;
+    while (painter->player_id < PLAYER_SLOTS && server->players_by_id[painter->player_id] != NULL) {
+        painter->player_id++;
+    }
+    return painter->player_id < PLAYER_SLOTS;
+}
+
+static void _broadcast_block_packet(server_t* server, ENetPacket* packet)
+{
+    uint8_t   sent = 0;
+    player_t *player, *tmp;
+    HASH_ITER(hh, server->players, player, tmp)
+    {
+        if (is_past_state_data(player) && egress_send(server, player, packet, EGRESS_BLOCK) == 0) {
+            sent = 1;
+        }
+    }
+    if (sent == 0) {
+        enet_packet_destroy(packet);
+    }
+}
+
+void send_restored_block(server_t* server, void* painter, vector3i_t position, uint8_t solid, uint32_t color)
+{
+    block_painter_t* block_painter = (block_painter_t*) painter;
+    if (solid && (!block_painter->painting || block_painter->color != color)) {
+        packet_set_color_t set_color = {block_painter->player_id, {.raw = color}};
+        _broadcast_block_packet(server, packet_set_color_create(&set_color, ENET_PACKET_FLAG_RELIABLE));
+        block_painter->painting = 1;
+        block_painter->color    = color;
+    }
+    packet_block_action_t block_action = {
+    block_painter->player_id, solid ? BLOCKACTION_BUILD : BLOCKACTION_DESTROY_ONE, position};
+    _broadcast_block_packet(server, packet_block_action_create(&block_action, ENET_PACKET_FLAG_RELIABLE));
+}
+
 void receive_block_action(server_t* server, player_t* player, stream_t* data)
 {
-    uint8_t received_id = stream_read_u8(data);
+    packet_block_action_t received;
+    if (!packet_block_action_read(data, &received)) {
+        return;
+    }
+    uint8_t received_id = received.player_id;
     if (player->id != received_id) {
         LOG_WARNING("Assigned ID: %d doesnt match sent ID: %d in block action packet", player->id, received_id);
     }
     if (!(player->can_build && server->global_ab) || player->sprinting) {
         return;
     }
-    uint8_t    action_type   = stream_read_u8(data);
-    uint32_t   X             = stream_read_u32(data);
-    uint32_t   Y             = stream_read_u32(data);
-    uint32_t   Z             = stream_read_u32(data);
+    uint8_t    action_type   = received.action_type;
+    uint32_t   X             = received.position.x;
+    uint32_t   Y             = received.position.y;
+    uint32_t   Z             = received.position.z;
     vector3i_t vector_block  = {X, Y, Z};
     vector3f_t vectorf_block = {(float) X, (float) Y, (float) Z};
     vector3f_t player_vector = player->movement.position;
@@ -108,5 +144,5 @@ void receive_block_action(server_t* server, player_t* player, stream_t* data)
         return;
     }
     handle_block_action(server, player, action_type, vector_block, vectorf_block, player_vector, X, Y, Z);
-    move_intel_and_tent_down(server);
+    gamemode_block_destroyed(server);
 }
@@ -1,10 +1,15 @@
-#include <Server/IntelTent.h>
+#include <Server/Egress.h>
+#include <Server/Gamemodes/Gamemodes.h>
+#include <Server/Map.h>
+#include <Server/Packets/Schema.h>
+#include <Server/Player.h>
 #include <Server/Server.h>
 #include <Util/Checks/PlayerChecks.h>
 #include <Util/Checks/PositionChecks.h>
 #include <Util/Checks/TimeChecks.h>
 #include <Util/Checks/BlockChecks.h>
 #include <Util/Enums.h>
+#include <Util/Line.h>
 #include <Util/Log.h>
 #include <Util/Nanos.h>
 #include <Util/Uthash.h>
@@ -16,22 +21,16 @@ void send_block_line(server_t* server, player_t* player, vector3i_t start, vecto
     if (server->protocol.num_players == 0) {
         return;
     }
-    ENetPacket* packet = enet_packet_create(NULL, 26, ENET_PACKET_FLAG_RELIABLE);
-    stream_t    stream = {packet->data, packet->dataLength, 0};
-    stream_write_u8(&stream, PACKET_TYPE_BLOCK_LINE);
-    stream_write_u8(&stream, player->id);
-    stream_write_u32(&stream, start.x);
-    stream_write_u32(&stream, start.y);
-    stream_write_u32(&stream, start.z);
-    stream_write_u32(&stream, end.x);
-    stream_write_u32(&stream, end.y);
-    stream_write_u32(&stream, end.z);
+    // Clients paint the line with the last colour they got for this player, it must not lag behind
+    flush_pending_broadcasts(server, player);
+    packet_block_line_t block_line = {player->id, start, end};
+    ENetPacket*         packet     = packet_block_line_create(&block_line, ENET_PACKET_FLAG_RELIABLE);
     uint8_t   sent = 0;
     player_t *check, *tmp;
     HASH_ITER(hh, server->players, check, tmp)
     {
         if (is_past_state_data(check)) {
-            if (enet_peer_send(check->peer, 0, packet) == 0) {
+            if (egress_send(server, check, packet, EGRESS_BLOCK) == 0) {
                 sent = 1;
             }
         } else if (check->state == STATE_STARTING_MAP || check->state == STATE_LOADING_CHUNKS) {
@@ -58,18 +57,10 @@ void send_block_line_to_player(server_t* server, player_t* player, player_t* rec
     if (server->protocol.num_players == 0) {
         return;
     }
-    ENetPacket* packet = enet_packet_create(NULL, 26, ENET_PACKET_FLAG_RELIABLE);
-    stream_t    stream = {packet->data, packet->dataLength, 0};
-    stream_write_u8(&stream, PACKET_TYPE_BLOCK_LINE);
-    stream_write_u8(&stream, player->id);
-    stream_write_u32(&stream, start.x);
-    stream_write_u32(&stream, start.y);
-    stream_write_u32(&stream, start.z);
-    stream_write_u32(&stream, end.x);
-    stream_write_u32(&stream, end.y);
-    stream_write_u32(&stream, end.z);
+    packet_block_line_t block_line = {player->id, start, end};
+    ENetPacket*         packet     = packet_block_line_create(&block_line, ENET_PACKET_FLAG_RELIABLE);
     uint8_t sent = 0;
-    if (enet_peer_send(receiver->peer, 0, packet) == 0) {
+    if (egress_send(server, receiver, packet, EGRESS_BLOCK) == 0) {
         sent = 1;
     }
     if (sent == 0) {
@@ -79,7 +70,11 @@ void send_block_line_to_player(server_t* server, player_t* player, player_t* rec
 
 void receive_block_line(server_t* server, player_t* player, stream_t* data)
 {
-    uint8_t received_id = stream_read_u8(data);
+    packet_block_line_t received;
+    if (!packet_block_line_read(data, &received)) {
+        return;
+    }
+    uint8_t received_id = received.player_id;
     if (player->id != received_id) {
         LOG_WARNING("Assigned ID: %d doesnt match sent ID: %d in blockline packet", player->id, received_id);
     }
@@ -94,14 +89,8 @@ void receive_block_line(server_t* server, player_t* player, stream_t* data)
         diff_is_older_then_dont_update(time_now, player->timers.since_last_block_dest, BLOCK_DELAY) &&
         diff_is_older_then_dont_update(time_now, player->timers.since_last_3block_dest, BLOCK_DELAY))
     {
-        vector3i_t start;
-        vector3i_t end;
-        start.x = stream_read_u32(data);
-        start.y = stream_read_u32(data);
-        start.z = stream_read_u32(data);
-        end.x   = stream_read_u32(data);
-        end.y   = stream_read_u32(data);
-        end.z   = stream_read_u32(data);
+        vector3i_t start = received.start;
+        vector3i_t end   = received.end;
 
         if (!is_block_placable(server, start) || !is_block_placable(server, end)) {
             return;
@@ -112,16 +101,12 @@ void receive_block_line(server_t* server, player_t* player, stream_t* data)
         if (distance_in_3d(endF, player->movement.position) <= 4 && distance_in_3d(startF, player->locAtClick) <= 4 &&
             valid_pos_v3f(server, startF) && valid_pos_v3f(server, endF))
         {
-            int size = line_get_blocks(&start, &end, server->s_map.result_line);
+            vector3i_t line[LINE_MAX_LENGTH];
+            vector3i_t map_size = {server->s_map.map.size_x, server->s_map.map.size_y, server->s_map.map.size_z};
+            int        size     = line_get_blocks(&start, &end, map_size, line);
             player->blocks -= size;
-            for (int i = 0; i < size; i++) {
-                mapvxl_set_color(&server->s_map.map,
-                                 server->s_map.result_line[i].x,
-                                 server->s_map.result_line[i].y,
-                                 server->s_map.result_line[i].z,
-                                 player->tool_color.raw);
-            }
-            moveIntelAndTentUp(server);
+            map_set_color_many(server, player->id, line, size, player->tool_color.raw);
+            gamemode_block_built(server);
             send_block_line(server, player, start, end);
         }
     }
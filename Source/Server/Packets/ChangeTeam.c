@@ -1,4 +1,6 @@
 #include <Server/Packets/Packets.h>
+#include <Server/Packets/Schema.h>
+#include <Server/Player.h>
 #include <Server/Server.h>
 #include <Util/Log.h>
 
@@ -6,9 +8,13 @@ void receive_change_team(server_t* server, player_t* player, stream_t* data)
 {
     // @Todo: if player is not initialised yet (pyspades uses if not self.name) ignore this
 
-    uint8_t received_id = stream_read_u8(data);
+    packet_change_team_t received;
+    if (!packet_change_team_read(data, &received)) {
+        return;
+    }
+    uint8_t received_id = received.player_id;
 
-    uint8_t team     = stream_read_u8(data);
+    uint8_t team     = received.team;
     uint8_t old_team = player->team;
 
     if (old_team == team)
@@ -23,11 +29,7 @@ void receive_change_team(server_t* server, player_t* player, stream_t* data)
         LOG_WARNING("Assigned ID: %d doesnt match sent ID: %d in change team packet", player->id, received_id);
     }
 
-    if (server->protocol.num_team_users[old_team] > 0)
-        server->protocol.num_team_users[old_team]--;
-
-    player->team = team;
-    server->protocol.num_team_users[team]++;
+    player_set_team(server, player, team);
 
     if (old_team == TEAM_SPECTATOR) {
         send_respawn(server, player);
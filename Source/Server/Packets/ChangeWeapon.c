@@ -1,11 +1,16 @@
 #include <Server/Packets/Packets.h>
+#include <Server/Packets/Schema.h>
 #include <Server/Server.h>
 #include <Util/Log.h>
 
 void receive_change_weapon(server_t* server, player_t* player, stream_t* data)
 {
-    uint8_t received_id     = stream_read_u8(data);
-    uint8_t received_weapon = stream_read_u8(data);
+    packet_change_weapon_t received;
+    if (!packet_change_weapon_read(data, &received)) {
+        return;
+    }
+    uint8_t received_id     = received.player_id;
+    uint8_t received_weapon = received.weapon;
     if (player->weapon == received_weapon) {
         return;
     }
@@ -1,21 +1,22 @@
+#include <Server/Packets/Schema.h>
 #include <Server/Server.h>
 #include <Util/Checks/PlayerChecks.h>
 #include <Util/Log.h>
 #include <Util/Uthash.h>
 
+static ENetPacket* _create_player_packet(player_t* child)
+{
+    packet_create_player_t create_player = {child->id, child->weapon, child->team, child->movement.position, {0}};
+    memcpy(create_player.name, child->name, PLAYER_NAME_STRLEN);
+    return packet_create_player_create(&create_player, ENET_PACKET_FLAG_RELIABLE);
+}
+
 void send_create_player(server_t* server, player_t* receiver, player_t* child)
 {
     if (server->protocol.num_players == 0) {
         return;
     }
-    ENetPacket* packet = enet_packet_create(NULL, 32, ENET_PACKET_FLAG_RELIABLE);
-    stream_t    stream = {packet->data, packet->dataLength, 0};
-    stream_write_u8(&stream, PACKET_TYPE_CREATE_PLAYER);
-    stream_write_u8(&stream, child->id);                      // ID
-    stream_write_u8(&stream, child->weapon);                  // WEAPON
-    stream_write_u8(&stream, child->team);                    // TEAM
-    stream_write_vector3f(&stream, child->movement.position); // X Y Z
-    stream_write_array(&stream, child->name, 16);             // NAME
+    ENetPacket* packet = _create_player_packet(child);
 
     if (enet_peer_send(receiver->peer, 0, packet) != 0) {
         LOG_WARNING("Failed to send player state");
@@ -23,14 +24,38 @@ void send_create_player(server_t* server, player_t* receiver, player_t* child)
     }
 }
 
-void send_respawn(server_t* server, player_t* respawn_player)
+void send_respawn_many(server_t* server, player_t** respawn_players, uint8_t count)
 {
+    // Everybody gets the same bytes, so encode every player once up front and let ENet reference count the packets
+    ENetPacket* packets[PLAYER_SLOTS];
+    uint8_t     sent[PLAYER_SLOTS] = {0};
+    for (uint8_t i = 0; i < count; ++i) {
+        packets[i] = _create_player_packet(respawn_players[i]);
+    }
     player_t *player, *tmp;
     HASH_ITER(hh, server->players, player, tmp)
     {
-        if (is_past_state_data(player)) {
-            send_create_player(server, player, respawn_player);
+        if (!is_past_state_data(player)) {
+            continue;
+        }
+        for (uint8_t i = 0; i < count; ++i) {
+            if (enet_peer_send(player->peer, 0, packets[i]) == 0) {
+                sent[i] = 1;
+            } else {
+                LOG_WARNING("Failed to send player state");
+            }
         }
     }
-    respawn_player->state = STATE_READY;
+    for (uint8_t i = 0; i < count; ++i) {
+        if (sent[i] == 0) {
+            enet_packet_destroy(packets[i]);
+        }
+        respawn_players[i]->state = STATE_READY;
+        EVENT_RUN(server, player_spawn, respawn_players[i]);
+    }
+}
+
+void send_respawn(server_t* server, player_t* respawn_player)
+{
+    send_respawn_many(server, &respawn_player, 1);
 }
@@ -1,6 +1,10 @@
 #include "Server/Structs/PlayerStruct.h"
+#include <Server/NameIndex.h>
 #include <Server/Packets/Packets.h>
+#include <Server/Packets/Schema.h>
 #include <Server/ParseConvert.h>
+#include <Server/Player.h>
+#include <Server/RateControl.h>
 #include <Server/Server.h>
 #include <Util/Alloc.h>
 #include <Util/Checks/PlayerChecks.h>
@@ -10,27 +14,80 @@
 #include <Util/Uthash.h>
 #include <Util/Utlist.h>
 #include <Util/Weapon.h>
-#include <ctype.h>
+#include <stdlib.h>
 
-void send_existing_player(server_t* server, player_t* receiver, player_t* existing_player)
+// All existing player packets for one joiner are encoded into a single blob. Every ENet packet only points into it
+// and the last one to be destroyed frees it.
+typedef struct existing_players_blob
+{
+    uint32_t references;
+    uint8_t  data[];
+} existing_players_blob_t;
+
+static void _existing_players_blob_release(ENetPacket* packet)
+{
+    existing_players_blob_t* blob = (existing_players_blob_t*) packet->userData;
+    if (--blob->references == 0) {
+        free(blob);
+    }
+}
+
+void send_existing_players(server_t* server, player_t* receiver)
 {
     if (server->protocol.num_players == 0) {
         return;
     }
-    ENetPacket* packet = enet_packet_create(NULL, 28, ENET_PACKET_FLAG_RELIABLE);
-    stream_t    stream = {packet->data, packet->dataLength, 0};
-    stream_write_u8(&stream, PACKET_TYPE_EXISTING_PLAYER);
-    stream_write_u8(&stream, existing_player->id);                // ID
-    stream_write_u8(&stream, existing_player->team);              // TEAM
-    stream_write_u8(&stream, existing_player->weapon);            // WEAPON
-    stream_write_u8(&stream, existing_player->item);              // HELD ITEM
-    stream_write_u32(&stream, existing_player->kills);            // KILLS
-    stream_write_color_rgb(&stream, existing_player->tool_color); // COLOR
-    stream_write_array(&stream, existing_player->name, PLAYER_NAME_STRLEN);       // NAME
-
-    if (enet_peer_send(receiver->peer, 0, packet) != 0) {
-        LOG_WARNING("Failed to send player state");
-        enet_packet_destroy(packet);
+    player_t *existing_player, *tmp;
+    uint32_t  count = 0;
+    HASH_ITER(hh, server->players, existing_player, tmp)
+    {
+        if (existing_player != receiver && is_past_join_screen(existing_player)) {
+            count++;
+        }
+    }
+    if (count == 0) {
+        return;
+    }
+
+    existing_players_blob_t* blob =
+    spadesx_malloc(sizeof(existing_players_blob_t) + (size_t) count * PACKET_SIZE_EXISTING_PLAYER);
+    blob->references = count;
+    uint8_t* out     = blob->data;
+    HASH_ITER(hh, server->players, existing_player, tmp)
+    {
+        if (existing_player == receiver || !is_past_join_screen(existing_player)) {
+            continue;
+        }
+        packet_existing_player_t existing = {existing_player->id,
+                                             existing_player->team,
+                                             existing_player->weapon,
+                                             existing_player->item,
+                                             existing_player->kills,
+                                             existing_player->tool_color,
+                                             {0}};
+        memcpy(existing.name, existing_player->name, PLAYER_NAME_STRLEN);
+        packet_existing_player_encode(out, &existing);
+        out += PACKET_SIZE_EXISTING_PLAYER;
+    }
+
+    // Packets have to stay separate on the wire, clients expect exactly one message per ENet packet
+    for (uint32_t i = 0; i < count; ++i) {
+        ENetPacket* packet = enet_packet_create(blob->data + i * PACKET_SIZE_EXISTING_PLAYER,
+                                                PACKET_SIZE_EXISTING_PLAYER,
+                                                ENET_PACKET_FLAG_RELIABLE | ENET_PACKET_FLAG_NO_ALLOCATE);
+        if (packet == NULL) {
+            blob->references -= count - i;
+            if (blob->references == 0) {
+                free(blob);
+            }
+            return;
+        }
+        packet->userData     = blob;
+        packet->freeCallback = _existing_players_blob_release;
+        if (enet_peer_send(receiver->peer, 0, packet) != 0) {
+            LOG_WARNING("Failed to send player state");
+            enet_packet_destroy(packet);
+        }
     }
 }
 
@@ -40,22 +97,20 @@ void receive_existing_player(server_t* server, player_t* player, stream_t* data)
         return;
     }
     stream_skip(data, 1); // Clients always send a "dumb" ID here since server has not sent them their ID yet
-    player->team   = stream_read_u8(data);
-    player->weapon = stream_read_u8(data);
-    player->item   = stream_read_u8(data);
-    player->kills  = stream_read_u32(data);
+    uint8_t new_team = stream_read_u8(data);
+    player->weapon   = stream_read_u8(data);
+    player->item     = stream_read_u8(data);
+    player->kills    = stream_read_u32(data);
 
-    if (player->team != TEAM_A && player->team != TEAM_B && player->team != TEAM_SPECTATOR) {
+    if (new_team != TEAM_A && new_team != TEAM_B && new_team != TEAM_SPECTATOR) {
         LOG_WARNING("Player %s (#%hhu) sent invalid team. Switching them to Spectator", player->name, player->id);
-        player->team = TEAM_SPECTATOR;
-    }
-
-    if (player->team != TEAM_SPECTATOR) {
-        server->protocol.num_team_users[player->team]++;
+        new_team = TEAM_SPECTATOR;
     }
+    player_set_team(server, player, new_team);
 
     stream_read_color_rgb(data);
     player->ups = 60;
+    rate_control_reset(player);
 
     uint32_t length  = stream_left(data);
     uint8_t  invName = 0;
@@ -75,67 +130,28 @@ void receive_existing_player(server_t* server, player_t* player, stream_t* data)
         invName = 1;
     }
 
-    char* lowerCaseName = spadesx_malloc((strlen(player->name) + 1) * sizeof(char));
-    snprintf(lowerCaseName, strlen(player->name), "%s", player->name);
-
-    for (uint32_t i = 0; i < strlen(player->name); ++i)
-        lowerCaseName[i] = tolower(lowerCaseName[i]);
-
-    char* unwantedNames[] = {"igger", "1gger", "igg3r", "1gg3r", NULL};
-
-    for (unsigned long index = 0; index < strlen(lowerCaseName); ++index) {
-        if (isgraph(lowerCaseName[index]) == 0 && lowerCaseName[index] != ' ') {
-            snprintf(player->name, strlen("Deuce") + 1, "Deuce");
-            invName = 1;
-        }
-    }
-
-    int index = 0;
-
-    while (unwantedNames[index] != NULL) {
-        if (strstr(lowerCaseName, unwantedNames[index]) != NULL &&
-            strncmp(unwantedNames[index], strstr(lowerCaseName, unwantedNames[index]), PLAYER_NAME_STRLEN) == 0)
-        {
-            snprintf(player->name, strlen("Deuce") + 1, "Deuce");
-            free(lowerCaseName);
-            return;
-        }
-        index++;
+    char folded[PLAYER_NAME_STRLEN + 1];
+    if (!name_fold(folded, player->name, PLAYER_NAME_STRLEN) || name_filter_match(server, folded)) {
+        snprintf(player->name, strlen("Deuce") + 1, "Deuce");
+        invName = 1;
     }
 
-    free(lowerCaseName);
-
-    // ensure the player has a unique name.
-    int       found_match = 0;
-    player_t *connected_player, *tmp;
-    char      new_name[PLAYER_NAME_STRLEN + 1] = "";
+    // ensure the player has a unique name. The player's own entry goes first in case they are renaming.
+    name_index_remove(server, player);
+    char new_name[PLAYER_NAME_STRLEN + 1] = "";
     strncpy(new_name, player->name, PLAYER_NAME_STRLEN);
     new_name[PLAYER_NAME_STRLEN] = '\0';
-    while (1) {
-        found_match = 0;
-        HASH_ITER(hh, server->players, connected_player, tmp)
-        {
-            if (!is_past_join_screen(connected_player) || connected_player->id == player->id) {
-                // nonapplicable
-                continue;
-            }
-
-            if (strncmp(new_name, connected_player->name, PLAYER_NAME_STRLEN) == 0) {
-                // found match
-                found_match = 1;
-            }
-        }
-
-        if (!found_match) {
-            // non-conflicting name. we're done here.
-            break;
-        }
-
+    // Every candidate is a different name and every other player takes up one of them at most, so one of the first
+    // PLAYER_SLOTS is free
+    uint32_t suffix = player->id + 15;
+    for (uint32_t tries = 0; tries < PLAYER_SLOTS && name_index_find(server, new_name, PLAYER_NAME_STRLEN) != NULL;
+         ++tries, ++suffix)
+    {
         strncpy(new_name, player->name, PLAYER_NAME_STRLEN);
         new_name[PLAYER_NAME_STRLEN] = '\0';
-        
+
         char id_str[4];
-        snprintf(id_str, 4, "%u", player->id + 15);
+        snprintf(id_str, sizeof(id_str), "%u", suffix);
 
         size_t name_len = strlen(new_name);
         size_t id_len = strlen(id_str);
@@ -148,6 +164,7 @@ void receive_existing_player(server_t* server, player_t* player, stream_t* data)
     player->name[0] = '\0';
     strncpy(player->name, new_name, PLAYER_NAME_STRLEN);
     player->name[PLAYER_NAME_STRLEN] = '\0';
+    name_index_add(server, player);
 
     set_default_player_ammo(player);
     player->state = STATE_SPAWNING;
@@ -160,14 +177,13 @@ void receive_existing_player(server_t* server, player_t* player, stream_t* data)
         string_node_t* welcomeMessage;
         DL_FOREACH(server->welcome_messages, welcomeMessage)
         {
-            send_server_notice(player, 0, welcomeMessage->string);
+            send_server_notice(server, player, 0, welcomeMessage->string);
         }
         if (invName) {
-            send_server_notice(player,
+            send_server_notice(server,
+                               player,
                                0,
-                               "Your name was either empty, had # in front of it, had unreadable character in it or "
-                               "contained something nasty. Your name "
-                               "has been set to %s",
+                               "Your name was either empty, had # in front of it, had unreadable character in it or " "contained something nasty. Your name " "has been set to %s",
                                player->name);
         }
         player->welcome_sent = 1; // So we dont send the message to the player on each time they spawn.
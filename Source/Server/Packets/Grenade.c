@@ -1,3 +1,4 @@
+#include <Server/Packets/Schema.h>
 #include <Server/Server.h>
 #include <Server/Staff.h>
 #include <Util/Checks/PacketChecks.h>
@@ -18,17 +19,8 @@ void send_grenade(server_t* server, player_t* player, float fuse, vector3f_t pos
     if (server->protocol.num_players == 0) {
         return;
     }
-    ENetPacket* packet = enet_packet_create(NULL, 30, ENET_PACKET_FLAG_RELIABLE);
-    stream_t    stream = {packet->data, packet->dataLength, 0};
-    stream_write_u8(&stream, PACKET_TYPE_GRENADE_PACKET);
-    stream_write_u8(&stream, player->id);
-    stream_write_f(&stream, fuse);
-    stream_write_f(&stream, position.x);
-    stream_write_f(&stream, position.y);
-    stream_write_f(&stream, position.z);
-    stream_write_f(&stream, velocity.x);
-    stream_write_f(&stream, velocity.y);
-    stream_write_f(&stream, velocity.z);
+    packet_grenade_t grenade = {player->id, fuse, position, velocity};
+    ENetPacket*      packet  = packet_grenade_create(&grenade, ENET_PACKET_FLAG_RELIABLE);
     if (send_packet_except_sender(server, packet, player) == 0) {
         enet_packet_destroy(packet);
     }
@@ -36,13 +28,17 @@ void send_grenade(server_t* server, player_t* player, float fuse, vector3f_t pos
 
 void receive_grenade_packet(server_t* server, player_t* player, stream_t* data)
 {
-    uint8_t ID = stream_read_u8(data);
+    packet_grenade_t received;
+    if (!packet_grenade_read(data, &received)) {
+        return;
+    }
+    uint8_t ID = received.player_id;
     if (player->id != ID) {
         LOG_WARNING("Assigned ID: %d doesnt match sent ID: %d in grenade packet", player->id, ID);
     }
 
     if (player->item != TOOL_GRENADE) {
-        send_server_notice(player, 0, "InstaSuicideNade detected. Grenade ineffective");
+        send_server_notice(server, player, 0, "InstaSuicideNade detected. Grenade ineffective");
         send_message_to_staff(server, "Player %s (#%hhu) tried to use InstaSpadeNade", player->name, player->id);
         return;
     }
@@ -61,26 +57,21 @@ void receive_grenade_packet(server_t* server, player_t* player, stream_t* data)
     if (player->grenades > 0) {
         grenade_t* grenade  = spadesx_malloc(sizeof(grenade_t));
 
-        float fuse = stream_read_f(data);
+        float fuse = received.fuse;
         if (isnan(fuse) || isinf(fuse)) {
             free(grenade);
             return;
         }
 
         grenade->fuse       = fminf(3.0f, fuse);
-        grenade->position.x = stream_read_f(data);
-        grenade->position.y = stream_read_f(data);
-        grenade->position.z = stream_read_f(data);
+        grenade->position   = received.position;
 
         if (!valid_vec3f(grenade->position)) {
             free(grenade);
             return;
         }
 
-        float velX = stream_read_f(data), velY = stream_read_f(data), velZ = stream_read_f(data);
-        grenade->velocity.x = velX;
-        grenade->velocity.y = velY;
-        grenade->velocity.z = velZ;
+        grenade->velocity = received.velocity;
 
         if (!valid_vec3f(grenade->velocity)) {
             free(grenade);
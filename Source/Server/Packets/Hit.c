@@ -1,4 +1,6 @@
+#include <Server/LagCompensation.h>
 #include <Server/Packets/Packets.h>
+#include <Server/Packets/Schema.h>
 #include <Server/Server.h>
 #include <Util/Checks/PositionChecks.h>
 #include <Util/Enums.h>
@@ -10,29 +12,54 @@
 // player_id is the player who fired.
 void receive_hit_packet(server_t* server, player_t* player, stream_t* data)
 {
-    uint8_t   hit_player_id = stream_read_u8(data);
-    hit_t     hit_type      = stream_read_u8(data);
+    packet_hit_t received;
+    if (!packet_hit_read(data, &received)) {
+        return;
+    }
+    uint8_t   hit_player_id = received.player_id;
+    hit_t     hit_type      = received.hit_type;
     player_t* hit_player;
     HASH_FIND(hh, server->players, &hit_player_id, sizeof(hit_player_id), hit_player);
     if (hit_player == NULL) {
         LOG_WARNING("Player %s (#%hhu) hit player who doesn't exist (#%hhu)", player->name, player->id, hit_player_id);
         return;
     }
-    vector3f_t shot_pos     = player->movement.position;
-    vector3f_t shot_eye_pos = player->movement.eye_pos;
-    vector3f_t hit_pos      = hit_player->movement.position;
-    vector3f_t shot_orien   = player->movement.forward_orientation;
-    float      distance     = distance_in_2d(shot_pos, hit_pos);
-    long       x = 0, y = 0, z = 0;
-
     if (player->sprinting || (player->item == TOOL_GUN && player->weapon_clip == 0)) {
         return; // Sprinting and hitting somebody is impossible
     }
 
     uint64_t timeNow = get_nanos();
 
-    if (allow_shot(
-        server, player, hit_player, timeNow, distance, &x, &y, &z, shot_pos, shot_orien, hit_pos, shot_eye_pos))
+    // Validate against where the shooter saw the victim, not where the victim is now. Without a round trip sample
+    // there is no view time to rewind to, and the current position is all there is
+    vector3f_t hit_pos   = hit_player->movement.position;
+    float      tolerance = LAG_COMPENSATION_BASE_TOLERANCE;
+    uint64_t   view_time;
+    if (lag_compensation_view_time(player, timeNow, &view_time) &&
+        lag_compensation_rewind(hit_player, view_time, &hit_pos, NULL))
+    {
+        tolerance = lag_compensation_tolerance(player);
+    }
+
+    vector3f_t shot_pos     = player->movement.position;
+    vector3f_t shot_eye_pos = player->movement.eye_pos;
+    vector3f_t shot_orien   = player->movement.forward_orientation;
+    float      distance     = distance_in_2d(shot_pos, hit_pos);
+    long       x = 0, y = 0, z = 0;
+
+    if (allow_shot(server,
+                   player,
+                   hit_player,
+                   timeNow,
+                   distance,
+                   &x,
+                   &y,
+                   &z,
+                   shot_pos,
+                   shot_orien,
+                   hit_pos,
+                   tolerance,
+                   shot_eye_pos))
     {
         if(player->item == TOOL_GUN && player->weapon_pellets != 0) {
             player->weapon_pellets--;
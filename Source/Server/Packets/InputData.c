@@ -1,4 +1,6 @@
 #include <Server/Packets/Packets.h>
+#include <Server/Packets/Schema.h>
+#include <Server/Player.h>
 #include <Server/Server.h>
 #include <Util/Checks/PacketChecks.h>
 #include <Util/Log.h>
@@ -8,11 +10,8 @@ void send_input_data(server_t* server, player_t* player)
     if (server->protocol.num_players == 0) {
         return;
     }
-    ENetPacket* packet = enet_packet_create(NULL, 3, ENET_PACKET_FLAG_RELIABLE);
-    stream_t    stream = {packet->data, packet->dataLength, 0};
-    stream_write_u8(&stream, PACKET_TYPE_INPUT_DATA);
-    stream_write_u8(&stream, player->id);
-    stream_write_u8(&stream, player->input);
+    packet_input_data_t input_data = {player->id, player->input};
+    ENetPacket*         packet     = packet_input_data_create(&input_data, ENET_PACKET_FLAG_RELIABLE);
     if (send_packet_except_sender_dist_check(server, packet, player) == 0) {
         enet_packet_destroy(packet);
     }
@@ -20,13 +19,19 @@ void send_input_data(server_t* server, player_t* player)
 
 void receive_input_data(server_t* server, player_t* player, stream_t* data)
 {
+    (void) server;
+
+    packet_input_data_t received;
+    if (!packet_input_data_read(data, &received)) {
+        return;
+    }
     uint8_t bits[8];
     uint8_t mask        = 1;
-    uint8_t received_id = stream_read_u8(data);
+    uint8_t received_id = received.player_id;
     if (player->id != received_id) {
         LOG_WARNING("Assigned ID: %d doesnt match sent ID: %d in Input packet", player->id, received_id);
     } else if (player->state == STATE_READY) {
-        player->input = stream_read_u8(data);
+        player->input = received.input;
         for (int i = 0; i < 8; i++) {
             bits[i] = (player->input >> i) & mask;
         }
@@ -45,8 +50,8 @@ void receive_input_data(server_t* server, player_t* player, stream_t* data)
         if (player->sprinting && player->secondary_fire) {
             // Some game clients dont care to send that they exited scope mode upon sprint start
             player->secondary_fire = 0;
-            send_weapon_input(server, player, 0);
+            queue_weapon_input(player, 0);
         }
-        send_input_data(server, player);
+        player->pending_broadcasts |= PLAYER_PENDING_INPUT_DATA;
     }
 }
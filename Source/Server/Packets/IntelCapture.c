@@ -1,3 +1,4 @@
+#include <Server/Packets/Schema.h>
 #include <Server/Server.h>
 #include <Util/Checks/PlayerChecks.h>
 #include <Util/Uthash.h>
@@ -16,11 +17,8 @@ void send_intel_capture(server_t* server, player_t* player, uint8_t winning)
     if (player->has_intel == 0 || server->protocol.gamemode.intel_held[team] == 0) {
         return;
     }
-    ENetPacket* packet = enet_packet_create(NULL, 3, ENET_PACKET_FLAG_RELIABLE);
-    stream_t    stream = {packet->data, packet->dataLength, 0};
-    stream_write_u8(&stream, PACKET_TYPE_INTEL_CAPTURE);
-    stream_write_u8(&stream, player->id);
-    stream_write_u8(&stream, winning);
+    packet_intel_capture_t intel_capture = {player->id, winning};
+    ENetPacket*            packet        = packet_intel_capture_create(&intel_capture, ENET_PACKET_FLAG_RELIABLE);
     player->has_intel                          = 0;
     server->protocol.gamemode.intel_held[team] = 0;
 
@@ -1,4 +1,5 @@
 #include <Server/Packets/Packets.h>
+#include <Server/Packets/Schema.h>
 #include <Server/Server.h>
 #include <Util/Checks/PlayerChecks.h>
 #include <Util/Log.h>
@@ -18,16 +19,12 @@ void send_intel_drop(server_t* server, player_t* player)
     if (player->has_intel == 0 || server->protocol.gamemode.intel_held[team] == 0) {
         return;
     }
-    ENetPacket* packet = enet_packet_create(NULL, 14, ENET_PACKET_FLAG_RELIABLE);
-    stream_t    stream = {packet->data, packet->dataLength, 0};
-    stream_write_u8(&stream, PACKET_TYPE_INTEL_DROP);
-    stream_write_u8(&stream, player->id);
+    packet_intel_drop_t intel_drop = {player->id, {0, 0, 0}};
     if (server->protocol.current_gamemode == GAME_MODE_BABEL) {
-        stream_write_f(&stream, (float) server->s_map.map.size_x / 2);
-        stream_write_f(&stream, (float) server->s_map.map.size_y / 2);
-        stream_write_f(
-        &stream,
-        (float) mapvxl_find_top_block(&server->s_map.map, server->s_map.map.size_x / 2, server->s_map.map.size_y / 2));
+        intel_drop.position.x = (float) server->s_map.map.size_x / 2;
+        intel_drop.position.y = (float) server->s_map.map.size_y / 2;
+        intel_drop.position.z =
+        (float) mapvxl_find_top_block(&server->s_map.map, server->s_map.map.size_x / 2, server->s_map.map.size_y / 2);
 
         server->protocol.gamemode.intel[team].x = (float) server->s_map.map.size_x / 2;
         server->protocol.gamemode.intel[team].y = (float) server->s_map.map.size_y / 2;
@@ -36,11 +33,10 @@ void send_intel_drop(server_t* server, player_t* player)
         server->protocol.gamemode.intel[player->team] = server->protocol.gamemode.intel[team];
         send_move_object(server, player->team, player->team, server->protocol.gamemode.intel[team]);
     } else {
-        stream_write_f(&stream, player->movement.position.x);
-        stream_write_f(&stream, player->movement.position.y);
-        stream_write_f(
-        &stream,
-        (float) mapvxl_find_top_block(&server->s_map.map, player->movement.position.x, player->movement.position.y));
+        intel_drop.position.x = player->movement.position.x;
+        intel_drop.position.y = player->movement.position.y;
+        intel_drop.position.z =
+        (float) mapvxl_find_top_block(&server->s_map.map, player->movement.position.x, player->movement.position.y);
 
         server->protocol.gamemode.intel[team].x = (int) player->movement.position.x;
         server->protocol.gamemode.intel[team].y = (int) player->movement.position.y;
@@ -55,8 +51,9 @@ void send_intel_drop(server_t* server, player_t* player)
              (int) server->protocol.gamemode.intel[team].x,
              (int) server->protocol.gamemode.intel[team].y,
              (int) server->protocol.gamemode.intel[team].z);
-    uint8_t   sent = 0;
-    player_t *connected_player, *tmp;
+    ENetPacket* packet = packet_intel_drop_create(&intel_drop, ENET_PACKET_FLAG_RELIABLE);
+    uint8_t     sent   = 0;
+    player_t *  connected_player, *tmp;
     HASH_ITER(hh, server->players, connected_player, tmp)
     {
         if (is_past_state_data(connected_player)) {
@@ -1,3 +1,4 @@
+#include <Server/Packets/Schema.h>
 #include <Server/Server.h>
 #include <Util/Checks/PlayerChecks.h>
 
@@ -15,10 +16,8 @@ void send_intel_pickup(server_t* server, player_t* player)
     if (player->has_intel == 1 || server->protocol.gamemode.intel_held[team] == 1) {
         return;
     }
-    ENetPacket* packet = enet_packet_create(NULL, 2, ENET_PACKET_FLAG_RELIABLE);
-    stream_t    stream = {packet->data, packet->dataLength, 0};
-    stream_write_u8(&stream, PACKET_TYPE_INTEL_PICKUP);
-    stream_write_u8(&stream, player->id);
+    packet_intel_pickup_t intel_pickup = {player->id};
+    ENetPacket*           packet       = packet_intel_pickup_create(&intel_pickup, ENET_PACKET_FLAG_RELIABLE);
     player->has_intel                                         = 1;
     server->protocol.gamemode.player_intel_team[player->team] = player->id;
     server->protocol.gamemode.intel_held[team]                = 1;
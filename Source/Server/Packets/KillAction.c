@@ -1,4 +1,5 @@
 #include <Server/Packets/Packets.h>
+#include <Server/Packets/Schema.h>
 #include <Server/Server.h>
 #include <Util/Checks/PlayerChecks.h>
 #include <Util/Enums.h>
@@ -22,13 +23,13 @@ void send_kill_action_packet(server_t* server,
         send_intel_drop(server, player);
     }
 
-    ENetPacket* packet = enet_packet_create(NULL, 5, ENET_PACKET_FLAG_RELIABLE);
-    stream_t    stream = {packet->data, packet->dataLength, 0};
-    stream_write_u8(&stream, PACKET_TYPE_KILL_ACTION);
-    stream_write_u8(&stream, player->id);  // Player that died.
-    stream_write_u8(&stream, killer->id);  // Player that killed.
-    stream_write_u8(&stream, killReason);  // Killing reason (1 is headshot)
-    stream_write_u8(&stream, respawnTime); // Time before respawn happens
+    packet_kill_action_t kill_action = {
+    player->id,  // Player that died.
+    killer->id,  // Player that killed.
+    killReason,  // Killing reason (1 is headshot)
+    respawnTime, // Time before respawn happens
+    };
+    ENetPacket* packet = packet_kill_action_create(&kill_action, ENET_PACKET_FLAG_RELIABLE);
     uint8_t   sent = 0;
     player_t *connected_player, *tmp;
     HASH_ITER(hh, server->players, connected_player, tmp)
@@ -53,6 +54,7 @@ void send_kill_action_packet(server_t* server,
         player->respawn_time                 = respawnTime;
         player->timers.start_of_respawn_wait = time(NULL);
         player->state                        = STATE_WAITING_FOR_RESPAWN;
+        EVENT_RUN(server, player_kill, killer, player, killReason);
         switch (player->weapon) {
             case WEAPON_RIFLE:
                 player->weapon_reserve  = 50;
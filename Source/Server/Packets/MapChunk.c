@@ -1,3 +1,4 @@
+#include <Server/Egress.h>
 #include <Server/Packets/Packets.h>
 #include <Server/Server.h>
 #include <Util/Log.h>
@@ -5,14 +6,20 @@
 
 void send_map_chunks(server_t* server, player_t* player)
 {
+    // Map transfer has the lowest priority, send only what the egress budget allows and continue next update
     queue_t *node, *tmp;
     DL_FOREACH_SAFE(player->map_queue, node, tmp)
     {
-        ENetPacket* packet = enet_packet_create(NULL, player->map_queue->length + 1, ENET_PACKET_FLAG_RELIABLE);
+        if (!egress_reserve(server, player, EGRESS_MAP, node->length + 1)) {
+            return;
+        }
+        ENetPacket* packet = enet_packet_create(NULL, node->length + 1, ENET_PACKET_FLAG_RELIABLE);
         stream_t    stream = {packet->data, packet->dataLength, 0};
         stream_write_u8(&stream, PACKET_TYPE_MAP_CHUNK);
-        stream_write_array(&stream, player->map_queue->block, player->map_queue->length);
-        enet_peer_send(player->peer, 0, packet);
+        stream_write_array(&stream, node->block, node->length);
+        if (enet_peer_send(player->peer, 0, packet) != 0) {
+            enet_packet_destroy(packet);
+        }
         free(node->block);
         DL_DELETE(player->map_queue, node);
         free(node);
@@ -1,4 +1,5 @@
 #include <Util/Utlist.h>
+#include <Server/Packets/Schema.h>
 #include <Server/Server.h>
 #include <Util/Compress.h>
 #include <Util/Alloc.h>
@@ -33,10 +34,8 @@ void send_map_start(server_t* server, player_t* player)
     }
 
     LOG_INFO("Sending map info to %s (#%hhu)", player->name, player->id);
-    ENetPacket* packet = enet_packet_create(NULL, 5, ENET_PACKET_FLAG_RELIABLE);
-    stream_t    stream = {packet->data, packet->dataLength, 0};
-    stream_write_u8(&stream, PACKET_TYPE_MAP_START);
-    stream_write_u32(&stream, compressed_map_size);
+    packet_map_start_t map_start = {compressed_map_size};
+    ENetPacket*        packet    = packet_map_start_create(&map_start, ENET_PACKET_FLAG_RELIABLE);
     if (enet_peer_send(player->peer, 0, packet) == 0) {
         player->state = STATE_LOADING_CHUNKS;
         LOG_INFO("Sending map chunks to %s (#%hhu)", player->name, player->id);
@@ -1,7 +1,8 @@
 #include <Server/Commands/Commands.h>
+#include <Server/Egress.h>
+#include <Server/Player.h>
 #include <Server/Server.h>
 #include <Server/Staff.h>
-#include <Util/Alloc.h>
 #include <Util/Checks/PlayerChecks.h>
 #include <Util/Checks/TimeChecks.h>
 #include <Util/Log.h>
@@ -11,26 +12,32 @@
 #include <ctype.h>
 #include <string.h>
 
+#define MESSAGE_MAX_LENGTH 2048 // Lets limit messages to 2048 characters
+
 void receive_handle_send_message(server_t* server, player_t* player, stream_t* data)
 {
     if (server->protocol.num_players == 0) {
         return;
     }
-    uint32_t packet_size = data->length;
     uint8_t  received_id = stream_read_u8(data);
     int      meant_for   = stream_read_u8(data);
     uint32_t length      = stream_left(data);
-    if (length > 2048) {
-        length = 2048; // Lets limit messages to 2048 characters
+    if (length > MESSAGE_MAX_LENGTH) {
+        length = MESSAGE_MAX_LENGTH;
     }
-    char* message = spadesx_calloc(
-    length + 1, sizeof(char)); // Allocated 1 more byte in the case that client sent us non null ending string
+    char message[MESSAGE_MAX_LENGTH + 1]; // 1 more byte in the case that client sent us non null ending string
     stream_read_array(data, message, length);
-    if (message[length - 1] != '\0') {
-        message[length] = '\0';
-        length++;
-        packet_size = length + 3;
+    message[length] = '\0';
+
+    // Single pass: find the real end of the string and check every character on the way
+    uint8_t unreadable = 0;
+    for (length = 0; message[length] != '\0'; ++length) {
+        unsigned char character = message[length];
+        if (character < 0x80 && isgraph(character) == 0 && character != ' ' && character > '\b') {
+            unreadable = 1;
+        }
     }
+
     if (player->id != received_id) {
         LOG_WARNING("Assigned ID: %d doesnt match sent ID: %d in message packet", player->id, received_id);
     }
@@ -43,10 +50,10 @@ void receive_handle_send_message(server_t* server, player_t* player, stream_t* d
         if (player->spam_counter >= 5) {
             send_message_to_staff(
             server, "WARNING: Player %s (#%d) is trying to spam. Muting.", player->name, player->id);
-            send_server_notice(player,
+            send_server_notice(server,
+                               player,
                                0,
-                               "SERVER: You have been muted for excessive spam. If you feel like this is a mistake "
-                               "contact staff via /admin command");
+                               "SERVER: You have been muted for excessive spam. If you feel like this is a mistake " "contact staff via /admin command");
             player->muted        = 1;
             player->spam_counter = 0;
         }
@@ -60,19 +67,18 @@ void receive_handle_send_message(server_t* server, player_t* player, stream_t* d
     if (!diff_is_older_then(get_nanos(), &player->timers.since_last_message, (uint64_t) NANO_IN_MILLI * 400) &&
         player->permissions <= 1)
     {
-        send_server_notice(player, 0, "WARNING: You sent last message too fast and thus was not sent out to players");
+        send_server_notice(
+        server, player, 0, "WARNING: You sent last message too fast and thus was not sent out to players");
         return;
     }
 
-    for (unsigned long index = 0; index < strlen(message); ++index) {
-        if (isgraph(message[index]) == 0 && message[index] != ' ' && message[index] > '\b') {
-            send_server_notice(
-            player, 0, "WARNING: The message you sent contained unreadable characters and thus was ignored");
-            LOG_WARNING("Player %s (#%hhu) tried to send message containing unreadable character. Message ignored",
-                        player->name,
-                        player->id);
-            return;
-        }
+    if (unreadable) {
+        send_server_notice(
+        server, player, 0, "WARNING: The message you sent contained unreadable characters and thus was ignored");
+        LOG_WARNING("Player %s (#%hhu) tried to send message containing unreadable character. Message ignored",
+                    player->name,
+                    player->id);
+        return;
     }
 
     char meantFor[7];
@@ -89,32 +95,45 @@ void receive_handle_send_message(server_t* server, player_t* player, stream_t* d
     }
     LOG_INFO("Player %s (#%hhu) (%s) said: %s", player->name, player->id, meantFor, message);
 
-    uint8_t sent = 0;
     if (message[0] == '/') {
         command_handle(server, player, message, 0);
+        return;
+    }
+    if (player->muted || (meant_for != TEAM_A && meant_for != TEAM_B)) {
+        return;
+    }
+    EVENT_RUN(server, chat, player, meant_for, message);
+
+    uint32_t receivers;
+    if (meant_for == TEAM_A) { // Global
+        receivers = server->protocol.team_members[0] | server->protocol.team_members[1] | server->protocol.team_members[2];
     } else {
-        if (!player->muted) {
-            ENetPacket* packet = enet_packet_create(NULL, packet_size, ENET_PACKET_FLAG_RELIABLE);
-            stream_t    stream = {packet->data, packet->dataLength, 0};
-            stream_write_u8(&stream, PACKET_TYPE_CHAT_MESSAGE);
-            stream_write_u8(&stream, player->id);
-            stream_write_u8(&stream, meant_for);
-            stream_write_array(&stream, message, length);
-            player_t *connected_player, *tmp;
-            HASH_ITER(hh, server->players, connected_player, tmp)
-            {
-                if (is_past_join_screen(connected_player) && !player->muted &&
-                    ((connected_player->team == player->team && meant_for == TEAM_B) || meant_for == TEAM_A))
-                {
-                    if (enet_peer_send(connected_player->peer, 0, packet) == 0) {
-                        sent = 1;
-                    }
-                }
-            }
-            if (sent == 0) {
-                enet_packet_destroy(packet);
-            }
+        receivers = server->protocol.team_members[team_members_index(player->team)];
+    }
+    if (receivers == 0) {
+        return;
+    }
+
+    // Clients expect the string to be null terminated
+    ENetPacket* packet = enet_packet_create(NULL, 3 + length + 1, ENET_PACKET_FLAG_RELIABLE);
+    stream_t    stream = {packet->data, packet->dataLength, 0};
+    stream_write_u8(&stream, PACKET_TYPE_CHAT_MESSAGE);
+    stream_write_u8(&stream, player->id);
+    stream_write_u8(&stream, meant_for);
+    stream_write_array(&stream, message, length + 1);
+
+    uint8_t sent = 0;
+    while (receivers != 0) {
+        uint8_t   id       = __builtin_ctz(receivers);
+        player_t* receiver = server->players_by_id[id];
+        receivers &= receivers - 1;
+        if (receiver != NULL && is_past_join_screen(receiver) &&
+            egress_send(server, receiver, packet, EGRESS_CHAT) == 0)
+        {
+            sent = 1;
         }
     }
-    free(message);
+    if (sent == 0) {
+        enet_packet_destroy(packet);
+    }
 }
@@ -1,3 +1,4 @@
+#include <Server/Packets/Schema.h>
 #include <Server/Server.h>
 #include <Util/Checks/PlayerChecks.h>
 #include <Util/Uthash.h>
@@ -7,14 +8,8 @@ void send_move_object(server_t* server, uint8_t object, uint8_t team, vector3f_t
     if (server->protocol.num_players == 0) {
         return;
     }
-    ENetPacket* packet = enet_packet_create(NULL, 15, ENET_PACKET_FLAG_RELIABLE);
-    stream_t    stream = {packet->data, packet->dataLength, 0};
-    stream_write_u8(&stream, PACKET_TYPE_MOVE_OBJECT);
-    stream_write_u8(&stream, object);
-    stream_write_u8(&stream, team);
-    stream_write_f(&stream, pos.x);
-    stream_write_f(&stream, pos.y);
-    stream_write_f(&stream, pos.z);
+    packet_move_object_t move_object = {object, team, pos};
+    ENetPacket*          packet      = packet_move_object_create(&move_object, ENET_PACKET_FLAG_RELIABLE);
 
     uint8_t   sent = 0;
     player_t *connected_player, *tmp;
@@ -1,4 +1,5 @@
 #include <Server/Packets/ReceivePackets.h>
+#include <Server/Packets/Schema.h>
 #include <Server/Server.h>
 #include <Util/Checks/VectorChecks.h>
 #include <Util/Physics.h>
@@ -8,7 +9,11 @@ void receive_orientation_data(server_t* server, player_t* player, stream_t* data
 {
     (void) server;
 
-    vector3f_t orientation = {stream_read_f(data), stream_read_f(data), stream_read_f(data)};
+    packet_orientation_data_t received;
+    if (!packet_orientation_data_read(data, &received)) {
+        return;
+    }
+    vector3f_t orientation = received.orientation;
 
     if ((orientation.x + orientation.y + orientation.z) == 0) {
         return;
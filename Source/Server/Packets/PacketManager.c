@@ -1,13 +1,12 @@
 #include <Server/Packets/Packets.h>
 #include <Server/Packets/ReceivePackets.h>
+#include <Server/Packets/Schema.h>
 #include <Util/Checks/TimeChecks.h>
 #include <Util/Enums.h>
 #include <Util/Log.h>
 #include <Util/Nanos.h>
 #include <Util/Physics.h>
-#include <Util/Uthash.h>
-#include <Util/Utlist.h>
-#include <Util/Alloc.h>
+#include <string.h>
 
 inline uint8_t allow_shot(server_t*  server,
                           player_t*  player,
@@ -20,6 +19,7 @@ inline uint8_t allow_shot(server_t*  server,
                           vector3f_t shot_pos,
                           vector3f_t shot_orien,
                           vector3f_t hit_pos,
+                          float      tolerance,
                           vector3f_t shot_eye_pos)
 {
     uint8_t ret = 0;
@@ -33,7 +33,11 @@ inline uint8_t allow_shot(server_t*  server,
         ((player->item == TOOL_SPADE && diff_is_older_then(time_now, &player->timers.since_last_shot, NANO_IN_MILLI * 100)) ||
          (player->item == TOOL_GUN && player->weapon_pellets != 0)) &&
         player->alive && player_hit->alive && (player->team != player_hit->team || player->allow_team_killing) &&
-        (player->allow_killing && server->global_ak) && physics_validate_hit(shot_pos, shot_orien, hit_pos, 5) &&
+        (player->allow_killing && server->global_ak) &&
+        physics_validate_hit(shot_pos, shot_orien, hit_pos, tolerance) &&
+        // Occlusion is deliberately not compensated, the rays run against the map as it is now. Blocks placed or
+        // removed between the shooter's view time and now can block a hit that was clear for the shooter or let one
+        // through that was not
         (physics_cast_ray(server,
                           shot_eye_pos.x,
                           shot_eye_pos.y,
@@ -65,52 +69,71 @@ inline uint8_t allow_shot(server_t*  server,
 
 void init_packets(server_t* server)
 {
-    server->packets            = NULL;
-    packet_manager_t packets[] = {{0, &receive_position_data},
-                                  {1, &receive_orientation_data},
-                                  {3, &receive_input_data},
-                                  {4, &receive_weapon_input},
-                                  {5, &receive_hit_packet},
-                                  {6, &receive_grenade_packet},
-                                  {7, &receive_set_tool},
-                                  {8, &receive_set_color},
-                                  {9, &receive_existing_player},
-                                  {10, &receive_short_player},
-                                  {13, &receive_block_action},
-                                  {14, &receive_block_line},
-                                  {17, &receive_handle_send_message},
-                                  {28, &receive_weapon_reload},
-                                  {29, &receive_change_team},
-                                  {30, &receive_change_weapon},
-                                  {34, &receive_version_response}};
+    // Minimum lengths include the packet id and cover every fixed size field the handler reads.
+    // Existing player carries a name of variable length, chat and version response are not in the schema.
+    packet_manager_t packets[] = {
+    {PACKET_TYPE_POSITION_DATA, PACKET_SIZE_POSITION_DATA, &receive_position_data},
+    {PACKET_TYPE_ORIENTATION_DATA, PACKET_SIZE_ORIENTATION_DATA, &receive_orientation_data},
+    {PACKET_TYPE_INPUT_DATA, PACKET_SIZE_INPUT_DATA, &receive_input_data},
+    {PACKET_TYPE_WEAPON_INPUT, PACKET_SIZE_WEAPON_INPUT, &receive_weapon_input},
+    {PACKET_TYPE_HIT_PACKET, PACKET_SIZE_HIT_PACKET, &receive_hit_packet},
+    {PACKET_TYPE_GRENADE_PACKET, PACKET_SIZE_GRENADE_PACKET, &receive_grenade_packet},
+    {PACKET_TYPE_SET_TOOL, PACKET_SIZE_SET_TOOL, &receive_set_tool},
+    {PACKET_TYPE_SET_COLOR, PACKET_SIZE_SET_COLOR, &receive_set_color},
+    {PACKET_TYPE_EXISTING_PLAYER, PACKET_SIZE_EXISTING_PLAYER - PLAYER_NAME_STRLEN, &receive_existing_player},
+    {PACKET_TYPE_SHORT_PLAYER_DATA, PACKET_SIZE_SHORT_PLAYER_DATA, &receive_short_player},
+    {PACKET_TYPE_BLOCK_ACTION, PACKET_SIZE_BLOCK_ACTION, &receive_block_action},
+    {PACKET_TYPE_BLOCK_LINE, PACKET_SIZE_BLOCK_LINE, &receive_block_line},
+    {PACKET_TYPE_CHAT_MESSAGE, 4, &receive_handle_send_message},
+    {PACKET_TYPE_WEAPON_RELOAD, PACKET_SIZE_WEAPON_RELOAD, &receive_weapon_reload},
+    {PACKET_TYPE_CHANGE_TEAM, PACKET_SIZE_CHANGE_TEAM, &receive_change_team},
+    {PACKET_TYPE_CHANGE_WEAPON, PACKET_SIZE_CHANGE_WEAPON, &receive_change_weapon},
+    {PACKET_TYPE_VERSION_RESPONSE, 5, &receive_version_response}};
+    memset(server->packets, 0, sizeof(server->packets));
     for (unsigned long i = 0; i < sizeof(packets) / sizeof(packet_manager_t); i++) {
-        packet_t* packet = spadesx_malloc(sizeof(packet_t));
-        packet->id       = packets[i].id;
-        packet->packet   = packets[i].packet;
-        HASH_ADD_INT(server->packets, id, packet);
+        packet_t* packet   = &server->packets[packets[i].id & 0xFF];
+        packet->packet     = packets[i].packet;
+        packet->min_length = packets[i].min_length;
     }
 }
 
 void free_all_packets(server_t* server)
 {
-    packet_t* current_packet;
-    packet_t* tmp;
-    HASH_ITER(hh, server->packets, current_packet, tmp)
-    {
-        HASH_DEL(server->packets, current_packet);
-        free(current_packet);
+    for (int id = 0; id < PACKET_TABLE_SIZE; id++) {
+        packet_t* packet = &server->packets[id];
+        if (packet->received == 0) {
+            continue;
+        }
+        LOG_INFO("Packet %3d: %llu received, %llu rejected",
+                 id,
+                 (unsigned long long) packet->received,
+                 (unsigned long long) packet->rejected);
     }
+    memset(server->packets, 0, sizeof(server->packets));
 }
 
 void on_packet_received(server_t* server, player_t* player, stream_t* data)
 {
-    uint8_t   type     = stream_read_u8(data);
-    packet_t* packet_p = NULL;
-    int       type_int = (int) type;
-    HASH_FIND_INT(server->packets, &type_int, packet_p);
-    if (packet_p == NULL) {
-        LOG_WARNING("Unknown packet with ID %d received", type_int);
+    if (data->length == 0) {
+        return;
+    }
+    uint8_t   type   = stream_read_u8(data);
+    packet_t* packet = &server->packets[type];
+    packet->received++;
+    if (packet->packet == NULL) {
+        packet->rejected++;
+        LOG_WARNING("Unknown packet with ID %d received", type);
+        return;
+    }
+    if (data->length < packet->min_length) {
+        packet->rejected++;
+        LOG_WARNING("Packet with ID %d from player %s (#%hhu) is too short (%u < %u bytes)",
+                    type,
+                    player->name,
+                    player->id,
+                    data->length,
+                    packet->min_length);
         return;
     }
-    packet_p->packet(server, player, data);
+    packet->packet(server, player, data);
 }
@@ -19,11 +19,33 @@ uint8_t allow_shot(server_t*  server,
                    vector3f_t shot_pos,
                    vector3f_t shot_orien,
                    vector3f_t hit_pos,
+                   float      tolerance,
                    vector3f_t shot_eye_pos); // Remove me from here later
 
 void send_restock(server_t* server, player_t* player);
+/**
+ * @brief Pick an unused player slot to send server side map edits as
+ *
+ * Clients build blocks of an unknown player with the last colour they got for that id, so restored blocks keep their
+ * colour without touching the tool colour of anybody playing.
+ *
+ * @return 0 when every slot is taken
+ */
+uint8_t block_painter_init(server_t* server, block_painter_t* painter);
+/**
+ * @brief Send a voxel the server put back to everyone, matches map_restore_fn_t with a block_painter_t argument
+ */
+void send_restored_block(server_t* server, void* painter, vector3i_t position, uint8_t solid, uint32_t color);
 void send_move_object(server_t* server, uint8_t object, uint8_t team, vector3f_t pos);
 void send_intel_capture(server_t* server, player_t* player, uint8_t winning);
+void send_territory_capture(server_t* server, uint8_t object, uint8_t winning, uint8_t team);
+/**
+ * @brief Tell everyone where a capture is heading, clients move the bar on their own from rate and progress
+ *
+ * @param rate Net players capturing, the bar moves by rate * TC_CAPTURE_RATE every second
+ * @param progress How far capturing_team got, 0 to 1
+ */
+void send_progress_bar(server_t* server, uint8_t object, uint8_t capturing_team, int8_t rate, float progress);
 void send_intel_pickup(server_t* server, player_t* player);
 void send_intel_drop(server_t* server, player_t* player);
 void send_grenade(server_t* server, player_t* player, float fuse, vector3f_t position, vector3f_t velocity);
@@ -66,11 +88,17 @@ void send_set_hp(server_t*  server,
                  uint8_t    respawn_time,
                  uint8_t    is_grenade,
                  vector3f_t position);
-void send_existing_player(server_t* server, player_t* receiver, player_t* existing_player);
+void send_existing_players(server_t* server, player_t* receiver);
 void send_map_start(server_t* server, player_t* player);
 void send_map_chunks(server_t* server, player_t* player);
 void send_create_player(server_t* server, player_t* receiver, player_t* child);
 void send_respawn(server_t* server, player_t* respawn_player);
+/**
+ * @brief Spawn many players at once, every create player packet is encoded once and sent in one pass over receivers
+ *
+ * @param count At most PLAYER_SLOTS
+ */
+void send_respawn_many(server_t* server, player_t** respawn_players, uint8_t count);
 void send_world_update(server_t* server, player_t* player);
 void send_position_packet(server_t* server, player_t* player, float x, float y, float z);
 void send_version_request(server_t* server, player_t* player);
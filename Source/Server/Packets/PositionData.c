@@ -1,4 +1,5 @@
 #include "Util/Log.h"
+#include <Server/Packets/Schema.h>
 #include <Server/Server.h>
 #include <Util/Checks/PositionChecks.h>
 #include <Util/Checks/VectorChecks.h>
@@ -8,12 +9,8 @@ void send_position_packet(server_t* server, player_t* player, float x, float y,
     if (server->protocol.num_players == 0) {
         return;
     }
-    ENetPacket* packet = enet_packet_create(NULL, 13, ENET_PACKET_FLAG_RELIABLE);
-    stream_t    stream = {packet->data, packet->dataLength, 0};
-    stream_write_u8(&stream, PACKET_TYPE_POSITION_DATA);
-    stream_write_f(&stream, x);
-    stream_write_f(&stream, y);
-    stream_write_f(&stream, z);
+    packet_position_data_t position_data = {{x, y, z}};
+    ENetPacket*            packet        = packet_position_data_create(&position_data, ENET_PACKET_FLAG_RELIABLE);
     if (enet_peer_send(player->peer, 0, packet) != 0) {
         enet_packet_destroy(packet);
     }
@@ -21,7 +18,11 @@ void send_position_packet(server_t* server, player_t* player, float x, float y,
 
 void receive_position_data(server_t* server, player_t* player, stream_t* data)
 {
-    vector3f_t position = {stream_read_f(data), stream_read_f(data), stream_read_f(data)};
+    packet_position_data_t received;
+    if (!packet_position_data_read(data, &received)) {
+        return;
+    }
+    vector3f_t position = received.position;
 
     if (!valid_vec3f(position)) {
         return;
@@ -0,0 +1,27 @@
+#include <Server/Packets/Schema.h>
+#include <Server/Server.h>
+#include <Util/Checks/PlayerChecks.h>
+#include <Util/Uthash.h>
+
+void send_progress_bar(server_t* server, uint8_t object, uint8_t capturing_team, int8_t rate, float progress)
+{
+    if (server->protocol.num_players == 0) {
+        return;
+    }
+    packet_progress_bar_t progress_bar = {object, capturing_team, rate, progress};
+    ENetPacket*           packet       = packet_progress_bar_create(&progress_bar, ENET_PACKET_FLAG_RELIABLE);
+
+    uint8_t   sent = 0;
+    player_t *connected_player, *tmp;
+    HASH_ITER(hh, server->players, connected_player, tmp)
+    {
+        if (is_past_state_data(connected_player)) {
+            if (enet_peer_send(connected_player->peer, 0, packet) == 0) {
+                sent = 1;
+            }
+        }
+    }
+    if (sent == 0) {
+        enet_packet_destroy(packet);
+    }
+}
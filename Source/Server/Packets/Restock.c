@@ -1,3 +1,4 @@
+#include <Server/Packets/Schema.h>
 #include <Server/Server.h>
 
 void send_restock(server_t* server, player_t* player)
@@ -5,10 +6,8 @@ void send_restock(server_t* server, player_t* player)
     if (server->protocol.num_players == 0) {
         return;
     }
-    ENetPacket* packet = enet_packet_create(NULL, 2, ENET_PACKET_FLAG_RELIABLE);
-    stream_t    stream = {packet->data, packet->dataLength, 0};
-    stream_write_u8(&stream, PACKET_TYPE_RESTOCK);
-    stream_write_u8(&stream, player->id);
+    packet_restock_t restock = {player->id};
+    ENetPacket*      packet  = packet_restock_create(&restock, ENET_PACKET_FLAG_RELIABLE);
     if (enet_peer_send(player->peer, 0, packet) != 0) {
         enet_packet_destroy(packet);
     }
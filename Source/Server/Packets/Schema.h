@@ -0,0 +1,289 @@
+#ifndef PACKETS_SCHEMA_H
+#define PACKETS_SCHEMA_H
+
+#include <Server/Structs/PlayerStruct.h>
+#include <Util/DataStream.h>
+#include <Util/Enums.h>
+#include <Util/Types.h>
+#include <enet/enet.h>
+#include <string.h>
+
+/*
+ * Fixed-layout packets of protocol 0.75, described once.
+ *
+ * For every entry of PACKET_SCHEMA this header generates:
+ *   packet_<name>_t              struct with one member per field (the packet id is implicit)
+ *   PACKET_SIZE_<ID>             wire size including the packet id, checked against the protocol at compile time
+ *   packet_<name>_encode()       straight-line encoder writing the id and all fields, no bounds checks
+ *   packet_<name>_decode()       straight-line decoder for the payload following the id
+ *   packet_<name>_read()         validates the payload length once and decodes it
+ *   packet_<name>_create()       allocates an ENet packet of exactly PACKET_SIZE_<ID> and encodes into it
+ *
+ * Variable length packets (world update, state data, map chunks, chat, version response) stay hand written.
+ */
+
+static inline vector3i_t schema_load_vector3i(const uint8_t* data)
+{
+    vector3i_t vector = {(int) stream_load_u32(data), (int) stream_load_u32(data + 4), (int) stream_load_u32(data + 8)};
+    return vector;
+}
+
+static inline void schema_store_vector3i(uint8_t* data, vector3i_t vector)
+{
+    stream_store_u32(data, vector.x);
+    stream_store_u32(data + 4, vector.y);
+    stream_store_u32(data + 8, vector.z);
+}
+
+// Field types: C type, array suffix, size on the wire, load and store
+#define SCHEMA_CTYPE_u8    uint8_t
+#define SCHEMA_CTYPE_s8    int8_t
+#define SCHEMA_CTYPE_u32   uint32_t
+#define SCHEMA_CTYPE_f32   float
+#define SCHEMA_CTYPE_vec3f vector3f_t
+#define SCHEMA_CTYPE_vec3i vector3i_t
+#define SCHEMA_CTYPE_color color_t
+#define SCHEMA_CTYPE_name  char
+
+#define SCHEMA_ARRAY_u8
+#define SCHEMA_ARRAY_s8
+#define SCHEMA_ARRAY_u32
+#define SCHEMA_ARRAY_f32
+#define SCHEMA_ARRAY_vec3f
+#define SCHEMA_ARRAY_vec3i
+#define SCHEMA_ARRAY_color
+#define SCHEMA_ARRAY_name [PLAYER_NAME_STRLEN]
+
+#define SCHEMA_SIZE_u8    1
+#define SCHEMA_SIZE_s8    1
+#define SCHEMA_SIZE_u32   4
+#define SCHEMA_SIZE_f32   4
+#define SCHEMA_SIZE_vec3f 12
+#define SCHEMA_SIZE_vec3i 12
+#define SCHEMA_SIZE_color 3
+#define SCHEMA_SIZE_name  PLAYER_NAME_STRLEN
+
+#define SCHEMA_LOAD_u8(in, out)    (out) = stream_load_u8(in)
+#define SCHEMA_LOAD_s8(in, out)    (out) = (int8_t) stream_load_u8(in)
+#define SCHEMA_LOAD_u32(in, out)   (out) = stream_load_u32(in)
+#define SCHEMA_LOAD_f32(in, out)   (out) = stream_load_f(in)
+#define SCHEMA_LOAD_vec3f(in, out) (out) = stream_load_vector3f(in)
+#define SCHEMA_LOAD_vec3i(in, out) (out) = schema_load_vector3i(in)
+#define SCHEMA_LOAD_color(in, out) (out) = stream_load_color_rgb(in)
+#define SCHEMA_LOAD_name(in, out)  memcpy((out), (in), PLAYER_NAME_STRLEN)
+
+#define SCHEMA_STORE_u8(out, value)    stream_store_u8(out, value)
+#define SCHEMA_STORE_s8(out, value)    stream_store_u8(out, (uint8_t) (value))
+#define SCHEMA_STORE_u32(out, value)   stream_store_u32(out, value)
+#define SCHEMA_STORE_f32(out, value)   stream_store_f(out, value)
+#define SCHEMA_STORE_vec3f(out, value) stream_store_vector3f(out, value)
+#define SCHEMA_STORE_vec3i(out, value) schema_store_vector3i(out, value)
+#define SCHEMA_STORE_color(out, value) stream_store_color_rgb(out, value)
+#define SCHEMA_STORE_name(out, value)  memcpy((out), (value), PLAYER_NAME_STRLEN)
+
+// PACKET(name, PACKET_TYPE_ suffix, size in bytes as documented by the 0.75 protocol)
+#define PACKET_SCHEMA(PACKET)                       \
+    PACKET(position_data, POSITION_DATA, 13)        \
+    PACKET(orientation_data, ORIENTATION_DATA, 13)  \
+    PACKET(input_data, INPUT_DATA, 3)               \
+    PACKET(weapon_input, WEAPON_INPUT, 3)           \
+    PACKET(hit, HIT_PACKET, 3)                      \
+    PACKET(set_hp, SET_HP, 15)                      \
+    PACKET(grenade, GRENADE_PACKET, 30)             \
+    PACKET(set_tool, SET_TOOL, 3)                   \
+    PACKET(set_color, SET_COLOR, 5)                 \
+    PACKET(existing_player, EXISTING_PLAYER, 28)    \
+    PACKET(short_player, SHORT_PLAYER_DATA, 4)      \
+    PACKET(move_object, MOVE_OBJECT, 15)            \
+    PACKET(create_player, CREATE_PLAYER, 32)        \
+    PACKET(block_action, BLOCK_ACTION, 15)          \
+    PACKET(block_line, BLOCK_LINE, 26)              \
+    PACKET(kill_action, KILL_ACTION, 5)             \
+    PACKET(map_start, MAP_START, 5)                 \
+    PACKET(player_left, PLAYER_LEFT, 2)             \
+    PACKET(territory_capture, TERRITORY_CAPTURE, 4) \
+    PACKET(progress_bar, PROGRESS_BAR, 8)           \
+    PACKET(intel_capture, INTEL_CAPTURE, 3)         \
+    PACKET(intel_pickup, INTEL_PICKUP, 2)           \
+    PACKET(intel_drop, INTEL_DROP, 14)              \
+    PACKET(restock, RESTOCK, 2)                     \
+    PACKET(weapon_reload, WEAPON_RELOAD, 4)         \
+    PACKET(change_team, CHANGE_TEAM, 3)             \
+    PACKET(change_weapon, CHANGE_WEAPON, 3)
+
+// Fields in wire order, FIELD(type, name)
+#define SCHEMA_FIELDS_position_data(FIELD) FIELD(vec3f, position)
+
+#define SCHEMA_FIELDS_orientation_data(FIELD) FIELD(vec3f, orientation)
+
+#define SCHEMA_FIELDS_input_data(FIELD) \
+    FIELD(u8, player_id)                \
+    FIELD(u8, input)
+
+#define SCHEMA_FIELDS_weapon_input(FIELD) \
+    FIELD(u8, player_id)                  \
+    FIELD(u8, input)
+
+#define SCHEMA_FIELDS_hit(FIELD) \
+    FIELD(u8, player_id)         \
+    FIELD(u8, hit_type)
+
+#define SCHEMA_FIELDS_set_hp(FIELD) \
+    FIELD(u8, hp)                   \
+    FIELD(u8, type)                 \
+    FIELD(vec3f, source)
+
+#define SCHEMA_FIELDS_grenade(FIELD) \
+    FIELD(u8, player_id)             \
+    FIELD(f32, fuse)                 \
+    FIELD(vec3f, position)           \
+    FIELD(vec3f, velocity)
+
+#define SCHEMA_FIELDS_set_tool(FIELD) \
+    FIELD(u8, player_id)              \
+    FIELD(u8, tool)
+
+#define SCHEMA_FIELDS_set_color(FIELD) \
+    FIELD(u8, player_id)               \
+    FIELD(color, color)
+
+#define SCHEMA_FIELDS_existing_player(FIELD) \
+    FIELD(u8, player_id)                     \
+    FIELD(u8, team)                          \
+    FIELD(u8, weapon)                        \
+    FIELD(u8, item)                          \
+    FIELD(u32, kills)                        \
+    FIELD(color, color)                      \
+    FIELD(name, name)
+
+#define SCHEMA_FIELDS_short_player(FIELD) \
+    FIELD(u8, player_id)                  \
+    FIELD(u8, team)                       \
+    FIELD(u8, weapon)
+
+#define SCHEMA_FIELDS_move_object(FIELD) \
+    FIELD(u8, object)                    \
+    FIELD(u8, team)                      \
+    FIELD(vec3f, position)
+
+#define SCHEMA_FIELDS_create_player(FIELD) \
+    FIELD(u8, player_id)                   \
+    FIELD(u8, weapon)                      \
+    FIELD(u8, team)                        \
+    FIELD(vec3f, position)                 \
+    FIELD(name, name)
+
+#define SCHEMA_FIELDS_block_action(FIELD) \
+    FIELD(u8, player_id)                  \
+    FIELD(u8, action_type)                \
+    FIELD(vec3i, position)
+
+#define SCHEMA_FIELDS_block_line(FIELD) \
+    FIELD(u8, player_id)                \
+    FIELD(vec3i, start)                 \
+    FIELD(vec3i, end)
+
+#define SCHEMA_FIELDS_kill_action(FIELD) \
+    FIELD(u8, player_id)                 \
+    FIELD(u8, killer_id)                 \
+    FIELD(u8, kill_type)                 \
+    FIELD(u8, respawn_time)
+
+#define SCHEMA_FIELDS_map_start(FIELD) FIELD(u32, map_size)
+
+#define SCHEMA_FIELDS_player_left(FIELD) FIELD(u8, player_id)
+
+#define SCHEMA_FIELDS_territory_capture(FIELD) \
+    FIELD(u8, object)                          \
+    FIELD(u8, winning)                         \
+    FIELD(u8, team)
+
+#define SCHEMA_FIELDS_progress_bar(FIELD) \
+    FIELD(u8, object)                     \
+    FIELD(u8, capturing_team)             \
+    FIELD(s8, rate)                       \
+    FIELD(f32, progress)
+
+#define SCHEMA_FIELDS_intel_capture(FIELD) \
+    FIELD(u8, player_id)                   \
+    FIELD(u8, winning)
+
+#define SCHEMA_FIELDS_intel_pickup(FIELD) FIELD(u8, player_id)
+
+#define SCHEMA_FIELDS_intel_drop(FIELD) \
+    FIELD(u8, player_id)                \
+    FIELD(vec3f, position)
+
+#define SCHEMA_FIELDS_restock(FIELD) FIELD(u8, player_id)
+
+#define SCHEMA_FIELDS_weapon_reload(FIELD) \
+    FIELD(u8, player_id)                   \
+    FIELD(u8, clip)                        \
+    FIELD(u8, reserve)
+
+#define SCHEMA_FIELDS_change_team(FIELD) \
+    FIELD(u8, player_id)                 \
+    FIELD(u8, team)
+
+#define SCHEMA_FIELDS_change_weapon(FIELD) \
+    FIELD(u8, player_id)                   \
+    FIELD(u8, weapon)
+
+/*
+ * Generators
+ */
+
+#define SCHEMA__STRUCT_FIELD(type, name) SCHEMA_CTYPE_##type name SCHEMA_ARRAY_##type;
+#define SCHEMA__SIZE_FIELD(type, name)   +SCHEMA_SIZE_##type
+#define SCHEMA__ENCODE_FIELD(type, name)         \
+    SCHEMA_STORE_##type(cursor, packet->name); \
+    cursor += SCHEMA_SIZE_##type;
+#define SCHEMA__DECODE_FIELD(type, name)        \
+    SCHEMA_LOAD_##type(cursor, packet->name); \
+    cursor += SCHEMA_SIZE_##type;
+
+#define SCHEMA__STRUCT(name, ID, size)                     \
+    typedef struct packet_##name                           \
+    {                                                      \
+        SCHEMA_FIELDS_##name(SCHEMA__STRUCT_FIELD)         \
+    } packet_##name##_t;                                   \
+    enum                                                   \
+    {                                                      \
+        PACKET_SIZE_##ID = 1 SCHEMA_FIELDS_##name(SCHEMA__SIZE_FIELD) \
+    };                                                     \
+    _Static_assert(PACKET_SIZE_##ID == (size), "Layout of packet " #name " does not match protocol 0.75");
+
+#define SCHEMA__CODEC(name, ID, size)                                                                       \
+    static inline void packet_##name##_encode(uint8_t* out, const packet_##name##_t* packet)                \
+    {                                                                                                       \
+        uint8_t* cursor = out;                                                                              \
+        *cursor++       = PACKET_TYPE_##ID;                                                                 \
+        SCHEMA_FIELDS_##name(SCHEMA__ENCODE_FIELD)                                                          \
+    }                                                                                                       \
+    static inline void packet_##name##_decode(const uint8_t* in, packet_##name##_t* packet)                 \
+    {                                                                                                       \
+        const uint8_t* cursor = in;                                                                         \
+        SCHEMA_FIELDS_##name(SCHEMA__DECODE_FIELD)                                                          \
+    }                                                                                                       \
+    static inline uint8_t packet_##name##_read(stream_t* stream, packet_##name##_t* packet)                 \
+    {                                                                                                       \
+        const uint8_t* view = stream_view(stream, PACKET_SIZE_##ID - 1);                                    \
+        if (view == NULL) {                                                                                 \
+            return 0;                                                                                       \
+        }                                                                                                   \
+        packet_##name##_decode(view, packet);                                                               \
+        return 1;                                                                                           \
+    }                                                                                                       \
+    static inline ENetPacket* packet_##name##_create(const packet_##name##_t* packet, uint32_t flags)       \
+    {                                                                                                       \
+        ENetPacket* enet_packet = enet_packet_create(NULL, PACKET_SIZE_##ID, flags);                        \
+        if (enet_packet != NULL) {                                                                          \
+            packet_##name##_encode(enet_packet->data, packet);                                              \
+        }                                                                                                   \
+        return enet_packet;                                                                                 \
+    }
+
+PACKET_SCHEMA(SCHEMA__STRUCT)
+PACKET_SCHEMA(SCHEMA__CODEC)
+
+#endif /* PACKETS_SCHEMA_H */
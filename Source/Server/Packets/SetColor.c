@@ -1,5 +1,8 @@
+#include <Server/Egress.h>
+#include <Server/Packets/Schema.h>
 #include <Server/Server.h>
 #include <Util/Checks/PacketChecks.h>
+#include <Util/Checks/PlayerChecks.h>
 #include <Util/Log.h>
 #include <Util/Uthash.h>
 
@@ -8,12 +11,20 @@ void send_set_color(server_t* server, player_t* player, color_t color)
     if (server->protocol.num_players == 0) {
         return;
     }
-    ENetPacket* packet = enet_packet_create(NULL, 5, ENET_PACKET_FLAG_RELIABLE);
-    stream_t    stream = {packet->data, packet->dataLength, 0};
-    stream_write_u8(&stream, PACKET_TYPE_SET_COLOR);
-    stream_write_u8(&stream, player->id);
-    stream_write_color_rgb(&stream, color);
-    if (send_packet_except_sender(server, packet, player) == 0) {
+    packet_set_color_t set_color = {player->id, color};
+    ENetPacket*        packet    = packet_set_color_create(&set_color, ENET_PACKET_FLAG_RELIABLE);
+    // Block class, not gameplay: clients paint placed blocks with the colour they last received for the sender
+    uint8_t   sent = 0;
+    player_t *connected_player, *tmp;
+    HASH_ITER(hh, server->players, connected_player, tmp)
+    {
+        if (connected_player != player && is_past_state_data(connected_player) &&
+            egress_send(server, connected_player, packet, EGRESS_BLOCK) == 0)
+        {
+            sent = 1;
+        }
+    }
+    if (sent == 0) {
         enet_packet_destroy(packet);
     }
 }
@@ -23,25 +34,28 @@ void send_set_color_to_player(server_t* server, player_t* player, player_t* rece
     if (server->protocol.num_players == 0) {
         return;
     }
-    ENetPacket* packet = enet_packet_create(NULL, 5, ENET_PACKET_FLAG_RELIABLE);
-    stream_t    stream = {packet->data, packet->dataLength, 0};
-    stream_write_u8(&stream, PACKET_TYPE_SET_COLOR);
-    stream_write_u8(&stream, player->id);
-    stream_write_color_rgb(&stream, color);
-    if (enet_peer_send(receiver->peer, 0, packet) != 0) {
+    packet_set_color_t set_color = {player->id, color};
+    ENetPacket*        packet    = packet_set_color_create(&set_color, ENET_PACKET_FLAG_RELIABLE);
+    if (egress_send(server, receiver, packet, EGRESS_BLOCK) != 0) {
         enet_packet_destroy(packet);
     }
 }
 
 void receive_set_color(server_t* server, player_t* player, stream_t* data)
 {
-    uint8_t received_id    = stream_read_u8(data);
-    color_t received_color = stream_read_color_rgb(data);
+    (void) server;
+
+    packet_set_color_t received;
+    if (!packet_set_color_read(data, &received)) {
+        return;
+    }
+    uint8_t received_id    = received.player_id;
+    color_t received_color = received.color;
 
     if (player->id != received_id) {
         LOG_WARNING("Assigned ID: %d doesnt match sent ID: %d in set color packet", player->id, received_id);
     }
 
     player->tool_color = received_color;
-    send_set_color(server, player, received_color);
+    player->pending_broadcasts |= PLAYER_PENDING_SET_COLOR;
 }
@@ -1,4 +1,5 @@
 #include <Server/Packets/Packets.h>
+#include <Server/Packets/Schema.h>
 #include <Server/Server.h>
 
 void send_set_hp(server_t*  server,
@@ -34,24 +35,13 @@ void send_set_hp(server_t*  server,
 
         else if (player_hit->hp > 0 && player_hit->hp < 100)
         {
-            ENetPacket* packet = enet_packet_create(NULL, 15, ENET_PACKET_FLAG_RELIABLE);
-            stream_t    stream = {packet->data, packet->dataLength, 0};
-            stream_write_u8(&stream, PACKET_TYPE_SET_HP);
-            stream_write_u8(&stream, player_hit->hp);
-            stream_write_u8(&stream, type_of_damage);
+            packet_set_hp_t set_hp = {player_hit->hp, type_of_damage, {0, 0, 0}};
             if (type_of_damage != 0 && is_grenade == 0) {
-                stream_write_f(&stream, player->movement.position.x);
-                stream_write_f(&stream, player->movement.position.y);
-                stream_write_f(&stream, player->movement.position.z);
+                set_hp.source = player->movement.position;
             } else if (type_of_damage != 0 && is_grenade == 1) {
-                stream_write_f(&stream, position.x);
-                stream_write_f(&stream, position.y);
-                stream_write_f(&stream, position.z);
-            } else {
-                stream_write_f(&stream, 0);
-                stream_write_f(&stream, 0);
-                stream_write_f(&stream, 0);
+                set_hp.source = position;
             }
+            ENetPacket* packet = packet_set_hp_create(&set_hp, ENET_PACKET_FLAG_RELIABLE);
             if (enet_peer_send(player_hit->peer, 0, packet) != 0) {
                 enet_packet_destroy(packet);
             }
@@ -1,4 +1,6 @@
 #include <Server/Packets/Packets.h>
+#include <Server/Packets/Schema.h>
+#include <Server/Player.h>
 #include <Server/Server.h>
 #include <Util/Checks/PacketChecks.h>
 #include <Util/Enums.h>
@@ -9,11 +11,8 @@ void send_set_tool(server_t* server, player_t* player, uint8_t tool)
     if (server->protocol.num_players == 0) {
         return;
     }
-    ENetPacket* packet = enet_packet_create(NULL, 3, ENET_PACKET_FLAG_RELIABLE);
-    stream_t    stream = {packet->data, packet->dataLength, 0};
-    stream_write_u8(&stream, PACKET_TYPE_SET_TOOL);
-    stream_write_u8(&stream, player->id);
-    stream_write_u8(&stream, tool);
+    packet_set_tool_t set_tool = {player->id, tool};
+    ENetPacket*       packet   = packet_set_tool_create(&set_tool, ENET_PACKET_FLAG_RELIABLE);
     if (send_packet_except_sender(server, packet, player) == 0) {
         enet_packet_destroy(packet);
     }
@@ -21,8 +20,12 @@ void send_set_tool(server_t* server, player_t* player, uint8_t tool)
 
 void receive_set_tool(server_t* server, player_t* player, stream_t* data)
 {
-    uint8_t received_id = stream_read_u8(data);
-    uint8_t tool        = stream_read_u8(data);
+    packet_set_tool_t received;
+    if (!packet_set_tool_read(data, &received)) {
+        return;
+    }
+    uint8_t received_id = received.player_id;
+    uint8_t tool        = received.tool;
     if (player->item == tool) {
         return;
     }
@@ -35,5 +38,5 @@ void receive_set_tool(server_t* server, player_t* player, stream_t* data)
         player->reloading = 0;
     }
     player->item = tool;
-    send_set_tool(server, player, tool);
+    player->pending_broadcasts |= PLAYER_PENDING_SET_TOOL;
 }
@@ -1,5 +1,7 @@
 #include <Server/Packets/Packets.h>
+#include <Server/Packets/Schema.h>
 #include <Server/ParseConvert.h>
+#include <Server/Player.h>
 #include <Util/DataStream.h>
 #include <Util/Enums.h>
 #include <Util/Log.h>
@@ -14,14 +16,19 @@ void receive_short_player(server_t* server, player_t* player, stream_t* data)
     if (player->team != TEAM_SPECTATOR) {
         return;
     }
-    stream_skip(data, 1); // Sender has to match the player we are getting info of.
-    player->team   = stream_read_u8(data);
-    player->weapon = stream_read_u8(data);
+    packet_short_player_t received;
+    if (!packet_short_player_read(data, &received)) {
+        return;
+    }
+    // Sender has to match the player we are getting info of, so the ID is ignored.
+    uint8_t new_team = received.team;
+    player->weapon   = received.weapon;
 
-    if (player->team != TEAM_A && player->team != TEAM_B && player->team != TEAM_SPECTATOR) {
+    if (new_team != TEAM_A && new_team != TEAM_B && new_team != TEAM_SPECTATOR) {
         LOG_WARNING("Player %s (#%hhu) sent invalid team. Switching them to Spectator", player->name, player->id);
-        player->team = TEAM_SPECTATOR;
+        new_team = TEAM_SPECTATOR;
     }
+    player_set_team(server, player, new_team);
 
     set_default_player_ammo(player);
 
@@ -5,7 +5,12 @@ void send_state_data(server_t* server, player_t* player)
     if (server->protocol.num_players == 0) {
         return;
     }
-    ENetPacket* packet = enet_packet_create(NULL, 104, ENET_PACKET_FLAG_RELIABLE);
+    size_t length = 104;
+    if (server->protocol.current_gamemode == GAME_MODE_TC) {
+        // Header, territory count and position and team of every territory
+        length = 32 + 1 + 13 * server->protocol.gamemode.tc.count;
+    }
+    ENetPacket* packet = enet_packet_create(NULL, length, ENET_PACKET_FLAG_RELIABLE);
     stream_t    stream = {packet->data, packet->dataLength, 0};
     stream_write_u8(&stream, PACKET_TYPE_STATE_DATA);
     stream_write_u8(&stream, player->id);
@@ -20,6 +25,16 @@ void send_state_data(server_t* server, player_t* player)
         stream_write_u8(&stream, 0);
     }
 
+    if (server->protocol.current_gamemode == GAME_MODE_TC) {
+        territory_control_t* tc = &server->protocol.gamemode.tc;
+        stream_write_u8(&stream, tc->count);
+        for (uint8_t i = 0; i < tc->count; ++i) {
+            stream_write_vector3f(&stream, tc->territories[i].position);
+            stream_write_u8(&stream, tc->territories[i].team);
+        }
+        goto send;
+    }
+
     // MODE CTF:
 
     stream_write_u8(&stream, server->protocol.gamemode.score[0]);    // SCORE TEAM A
@@ -59,6 +74,7 @@ void send_state_data(server_t* server, player_t* player)
     stream_write_vector3f(&stream, server->protocol.gamemode.base[0]);
     stream_write_vector3f(&stream, server->protocol.gamemode.base[1]);
 
+send:
     if (enet_peer_send(player->peer, 0, packet) == 0) {
         player->state = STATE_PICK_SCREEN;
     } else {
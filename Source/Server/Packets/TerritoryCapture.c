@@ -0,0 +1,27 @@
+#include <Server/Packets/Schema.h>
+#include <Server/Server.h>
+#include <Util/Checks/PlayerChecks.h>
+#include <Util/Uthash.h>
+
+void send_territory_capture(server_t* server, uint8_t object, uint8_t winning, uint8_t team)
+{
+    if (server->protocol.num_players == 0) {
+        return;
+    }
+    packet_territory_capture_t territory_capture = {object, winning, team};
+    ENetPacket* packet = packet_territory_capture_create(&territory_capture, ENET_PACKET_FLAG_RELIABLE);
+
+    uint8_t   sent = 0;
+    player_t *connected_player, *tmp;
+    HASH_ITER(hh, server->players, connected_player, tmp)
+    {
+        if (is_past_state_data(connected_player)) {
+            if (enet_peer_send(connected_player->peer, 0, packet) == 0) {
+                sent = 1;
+            }
+        }
+    }
+    if (sent == 0) {
+        enet_packet_destroy(packet);
+    }
+}
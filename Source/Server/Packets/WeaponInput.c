@@ -1,4 +1,6 @@
 #include <Server/Packets/Packets.h>
+#include <Server/Packets/Schema.h>
+#include <Server/Player.h>
 #include <Server/Server.h>
 #include <Server/Staff.h>
 #include <Util/Checks/PacketChecks.h>
@@ -16,14 +18,11 @@ void send_weapon_input(server_t* server, player_t* player, uint8_t wInput)
     if (server->protocol.num_players == 0) {
         return;
     }
-    ENetPacket* packet = enet_packet_create(NULL, 3, ENET_PACKET_FLAG_RELIABLE);
-    stream_t    stream = {packet->data, packet->dataLength, 0};
-    stream_write_u8(&stream, PACKET_TYPE_WEAPON_INPUT);
-    stream_write_u8(&stream, player->id);
     if (player->sprinting) {
         wInput = 0;
     }
-    stream_write_u8(&stream, wInput);
+    packet_weapon_input_t weapon_input = {player->id, wInput};
+    ENetPacket*           packet       = packet_weapon_input_create(&weapon_input, ENET_PACKET_FLAG_RELIABLE);
     if (send_packet_except_sender(server, packet, player) == 0) {
         enet_packet_destroy(packet);
     }
@@ -31,9 +30,13 @@ void send_weapon_input(server_t* server, player_t* player, uint8_t wInput)
 
 void receive_weapon_input(server_t* server, player_t* player, stream_t* data)
 {
+    packet_weapon_input_t received;
+    if (!packet_weapon_input_read(data, &received)) {
+        return;
+    }
     uint8_t mask           = 1;
-    uint8_t received_id    = stream_read_u8(data);
-    uint8_t received_input = stream_read_u8(data);
+    uint8_t received_id    = received.player_id;
+    uint8_t received_input = received.input;
     if (player->id != received_id) {
         LOG_WARNING("Assigned ID: %d doesnt match sent ID: %d in weapon input packet", player->id, received_id);
     } else if (player->state != STATE_READY) {
@@ -65,7 +68,7 @@ void receive_weapon_input(server_t* server, player_t* player, stream_t* data)
 
     else if (player->weapon_clip > 0 && player->item == TOOL_GUN)
     {
-        send_weapon_input(server, player, received_input);
+        queue_weapon_input(player, received_input);
         uint64_t timeDiff = get_player_weapon_delay_nano(player);
 
         if (player->primary_fire && diff_is_older_then(get_nanos(), &player->timers.since_last_weapon_input, timeDiff))
@@ -75,7 +78,7 @@ void receive_weapon_input(server_t* server, player_t* player, stream_t* data)
             if (player->weapon_clip == 0) {
                 player->primary_fire   = 0;
                 player->secondary_fire = 0;
-                send_weapon_input(server, player, 0);
+                queue_weapon_input(player, 0);
             }
             player->reloading = 0;
             if ((player->movement.previous_orientation.x == player->movement.forward_orientation.x) &&
@@ -89,7 +92,7 @@ void receive_weapon_input(server_t* server, player_t* player, stream_t* data)
                     if (is_past_join_screen(connected_player) && is_staff(server, connected_player)) {
                         char message[200];
                         snprintf(message, 200, "WARNING. Player %d may be using no recoil", player->id);
-                        send_server_notice(connected_player, 0, message);
+                        send_server_notice(server, connected_player, 0, message);
                     }
                 }
             }
@@ -1,3 +1,4 @@
+#include <Server/Packets/Schema.h>
 #include <Server/Server.h>
 #include <Util/Checks/PlayerChecks.h>
 #include <Util/Log.h>
@@ -8,17 +9,12 @@ void send_weapon_reload(server_t* server, player_t* player, uint8_t startAnimati
     if (server->protocol.num_players == 0) {
         return;
     }
-    ENetPacket* packet = enet_packet_create(NULL, 4, ENET_PACKET_FLAG_RELIABLE);
-    stream_t    stream = {packet->data, packet->dataLength, 0};
-    stream_write_u8(&stream, PACKET_TYPE_WEAPON_RELOAD);
-    stream_write_u8(&stream, player->id);
+    packet_weapon_reload_t weapon_reload = {player->id, player->weapon_clip, player->weapon_reserve};
     if (startAnimation) {
-        stream_write_u8(&stream, clip);
-        stream_write_u8(&stream, reserve);
-    } else {
-        stream_write_u8(&stream, player->weapon_clip);
-        stream_write_u8(&stream, player->weapon_reserve);
+        weapon_reload.clip    = clip;
+        weapon_reload.reserve = reserve;
     }
+    ENetPacket* packet = packet_weapon_reload_create(&weapon_reload, ENET_PACKET_FLAG_RELIABLE);
     if (startAnimation) {
         uint8_t   sendSucc = 0;
         player_t *connected_player, *tmp;
@@ -44,9 +40,13 @@ void send_weapon_reload(server_t* server, player_t* player, uint8_t startAnimati
 
 void receive_weapon_reload(server_t* server, player_t* player, stream_t* data)
 {
-    uint8_t ID      = stream_read_u8(data);
-    uint8_t clip    = stream_read_u8(data);
-    uint8_t reserve = stream_read_u8(data);
+    packet_weapon_reload_t received;
+    if (!packet_weapon_reload_read(data, &received)) {
+        return;
+    }
+    uint8_t ID      = received.player_id;
+    uint8_t clip    = received.clip;
+    uint8_t reserve = received.reserve;
     if (player->id != ID) {
         LOG_WARNING("Assigned ID: %d doesnt match sent ID: %d in weapon reload packet", player->id, ID);
     }
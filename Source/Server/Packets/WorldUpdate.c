@@ -1,3 +1,4 @@
+#include <Server/Egress.h>
 #include <Server/Server.h>
 #include <Util/Checks/PlayerChecks.h>
 #include <Util/Enums.h>
@@ -10,24 +11,25 @@ void send_world_update(server_t* server, player_t* player)
     }
     ENetPacket* packet = enet_packet_create(NULL, 1 + (32 * 24), 0);
     stream_t    stream = {packet->data, packet->dataLength, 0};
-    stream_write_u8(&stream, PACKET_TYPE_WORLD_UPDATE);
+    uint8_t*    view   = stream_view(&stream, 1 + (32 * 24));
+    stream_store_u8(view++, PACKET_TYPE_WORLD_UPDATE);
 
     player_t* connected_player;
-    for (uint8_t player_id = 0; player_id < server->protocol.max_players; ++player_id) {
+    for (uint8_t player_id = 0; player_id < server->protocol.max_players; ++player_id, view += 24) {
         HASH_FIND(hh, server->players, &player_id, sizeof(player_id), connected_player);
         if ((connected_player != NULL && connected_player->state != STATE_DISCONNECTED) &&
             player_to_player_visibile(player, connected_player) && connected_player->is_invisible == 0)
         {
-            stream_write_vector3f(&stream, connected_player->movement.position);
-            stream_write_vector3f(&stream, connected_player->movement.forward_orientation);
+            stream_store_vector3f(view, connected_player->movement.position);
+            stream_store_vector3f(view + 12, connected_player->movement.forward_orientation);
         } else {
             vector3f_t empty = {0};
             vector3f_t orientation = {1.0f, 0.0f, 0.0f};
-            stream_write_vector3f(&stream, empty);
-            stream_write_vector3f(&stream, orientation);
+            stream_store_vector3f(view, empty);
+            stream_store_vector3f(view + 12, orientation);
         }
     }
-    if (enet_peer_send(player->peer, 0, packet) != 0) {
+    if (egress_send(server, player, packet, EGRESS_GAMEPLAY) != 0) {
         enet_packet_destroy(packet);
     }
 }
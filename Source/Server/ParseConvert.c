@@ -1,3 +1,4 @@
+#include <Server/NameIndex.h>
 #include <Server/ParseConvert.h>
 #include <Server/Structs/ServerStruct.h>
 #include <Util/Types.h>
@@ -128,14 +129,23 @@ void team_id_to_str(server_t* server, char* dst, int team)
     snprintf(dst, 11, "%s", server->protocol.name_team[team]);
 }
 
-uint8_t parse_player(char* s, uint8_t* player_id, char** end)
+uint8_t parse_player(server_t* server, char* s, uint8_t* player_id, char** end)
 {
-    if (s[0] != '#' || strlen(s) < 2)
-    { // TODO: look up a player by their nickname if the argument doesn't start with #
-        return 0;
+    if (s[0] == '#' && strlen(s) >= 2) {
+        return parse_byte(s + 1, player_id, end);
     }
 
-    return parse_byte(s + 1, player_id, end);
+    // Anything else is a name, which ends at the first space when the caller wants the rest of the string
+    size_t    length = end != NULL ? strcspn(s, " \t") : strlen(s);
+    player_t* player = name_index_find(server, s, length);
+    if (player == NULL) {
+        return 0;
+    }
+    *player_id = player->id;
+    if (end) {
+        *end = s + length;
+    }
+    return 1;
 }
 
 uint8_t parse_byte(char* s, uint8_t* byte, char** end)
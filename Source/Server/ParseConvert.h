@@ -14,7 +14,7 @@ vector3i_t vec3f_to_vec3i(vector3f_t float_vec);
 uint8_t    format_str_to_ip(char* src, ip_t* dst);
 void       format_ip_to_str(char* dst, ip_t src);
 void       team_id_to_str(server_t* server, char* dst, int team);
-uint8_t    parse_player(char* s, uint8_t* player_id, char** end);
+uint8_t    parse_player(server_t* server, char* s, uint8_t* player_id, char** end);
 uint8_t    parse_byte(char* s, uint8_t* byte, char** end);
 uint8_t    parse_float(char* s, float* value, char** end);
 uint8_t    parse_ip(char* s, ip_t* ip, char** end);
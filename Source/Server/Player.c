@@ -1,8 +1,13 @@
+#include <Server/Egress.h>
+#include <Server/Gamemodes/Gamemodes.h>
 #include <Server/Grenade.h>
-#include <Server/IntelTent.h>
+#include <Server/LagCompensation.h>
+#include <Server/Map.h>
 #include <Server/Master.h>
 #include <Server/Packets/Packets.h>
 #include <Server/ParseConvert.h>
+#include <Server/Player.h>
+#include <Server/RateControl.h>
 #include <Server/Structs/PlayerStruct.h>
 #include <Server/Structs/ServerStruct.h>
 #include <Util/Alloc.h>
@@ -55,26 +60,81 @@ int player_sort(player_t* a, player_t* b)
     return 0;
 }
 
+void player_free_map_queue(player_t* player)
+{
+    queue_t *node, *tmp;
+    DL_FOREACH_SAFE(player->map_queue, node, tmp)
+    {
+        free(node->block);
+        DL_DELETE(player->map_queue, node);
+        free(node);
+    }
+    player->map_queue = NULL;
+}
+
 void free_all_players(server_t* server)
 {
     player_t *player, *tmp;
     HASH_ITER(hh, server->players, player, tmp)
     {
-        if (player->map_queue != NULL) {
-            queue_t *node, *tmp_queue;
-            DL_FOREACH_SAFE(player->map_queue, node, tmp_queue)
-            {
-                free(node->block);
-                DL_DELETE(player->map_queue, node);
-                free(node);
-            }
-            player->map_queue = NULL;
-        }
+        player_free_map_queue(player);
+        egress_reset(player);
+        server->players_by_id[player->id] = NULL;
         HASH_DEL(server->players, player);
         free(player);
     }
 }
 
+void player_leave_team(server_t* server, player_t* player)
+{
+    uint32_t bit = 1u << player->id;
+    // A freshly allocated player has no id yet and must not drop whoever owns id 0 from their team
+    if (server->players_by_id[player->id] != player ||
+        (server->protocol.team_members[team_members_index(player->team)] & bit) == 0)
+    {
+        return;
+    }
+    server->protocol.team_members[team_members_index(player->team)] &= ~bit;
+    if (server->protocol.num_team_users[player->team] > 0) {
+        server->protocol.num_team_users[player->team]--;
+    }
+}
+
+void player_set_team(server_t* server, player_t* player, uint8_t team)
+{
+    player_leave_team(server, player);
+    player->team = team;
+    server->protocol.team_members[team_members_index(team)] |= 1u << player->id;
+    server->protocol.num_team_users[team]++;
+}
+
+void queue_weapon_input(player_t* player, uint8_t input)
+{
+    player->pending_weapon_input = input;
+    player->pending_broadcasts |= PLAYER_PENDING_WEAPON_INPUT;
+}
+
+void flush_pending_broadcasts(server_t* server, player_t* player)
+{
+    uint8_t pending = player->pending_broadcasts;
+    if (pending == 0) {
+        return;
+    }
+    player->pending_broadcasts = 0;
+    if (pending & PLAYER_PENDING_SET_TOOL) {
+        send_set_tool(server, player, player->item);
+    }
+    if (pending & PLAYER_PENDING_SET_COLOR) {
+        send_set_color(server, player, player->tool_color);
+    }
+    if (pending & PLAYER_PENDING_INPUT_DATA) {
+        send_input_data(server, player);
+    }
+    if (pending & PLAYER_PENDING_WEAPON_INPUT) {
+        send_weapon_input(server, player, player->pending_weapon_input);
+    }
+}
+
 void update_movement_and_grenades(server_t* server)
 {
     server->physics.ftotclk =
@@ -84,9 +144,11 @@ void update_movement_and_grenades(server_t* server)
     player_t *player, *tmp;
     HASH_ITER(hh, server->players, player, tmp)
     {
+        flush_pending_broadcasts(server, player);
         if (player->state == STATE_READY) {
             long falldamage = 0;
             falldamage      = physics_move_player(server, player, &server->physics);
+            lag_compensation_record(player, server->global_timers.update_time);
             if (falldamage > 0) {
                 vector3f_t zero = {0, 0, 0};
                 send_set_hp(server, player, player, falldamage, 0, 4, 5, 0, zero);
@@ -102,6 +164,7 @@ void update_movement_and_grenades(server_t* server)
                 }
             }
         }
+        gamemode_player_move(server, player);
         handle_grenade(server, player);
     }
 }
@@ -139,6 +202,8 @@ static uint8_t is_valid_spawn_point(server_t* server, uint16_t x, uint16_t y, ui
 
 void set_player_respawn_point(server_t* server, player_t* player)
 {
+    // Never interpolate between the place of death and the new spawn
+    lag_compensation_reset(player);
     if (player->team != TEAM_SPECTATOR) {
         quad3d_t* spawn = server->protocol.spawns + player->team;
 
@@ -190,17 +255,11 @@ void init_player(server_t*  server,
     if (reset == 0) {
         player->state = STATE_DISCONNECTED;
     }
-    if (player->map_queue != NULL) {
-        queue_t *node, *tmp;
-        DL_FOREACH_SAFE(player->map_queue, node, tmp)
-        {
-            free(node->block);
-            DL_DELETE(player->map_queue, node);
-            free(node);
-        }
-        player->map_queue = NULL;
-    }
+    player_free_map_queue(player);
+    egress_reset(player);
+    player->pending_broadcasts           = 0;
     player->ups                          = 60;
+    rate_control_reset(player);
     player->timers.time_since_last_wu    = get_nanos();
     player->input                        = 0;
     player->movement.eye_pos             = empty;
@@ -237,6 +296,7 @@ void init_player(server_t*  server,
     player->allow_killing                        = 1;
     player->allow_team_killing                   = 0;
     player->muted                                = 0;
+    player_leave_team(server, player);
     player->team                                 = TEAM_SPECTATOR;
     player->timers.since_last_base_enter         = 0;
     player->timers.since_last_base_enter_restock = 0;
@@ -263,6 +323,7 @@ void init_player(server_t*  server,
     player->current_periodic_message             = server->periodic_messages;
     player->welcome_sent                         = 0;
     player->next_shot_invalid                    = 0;
+    lag_compensation_reset(player);
     if (reset == 0) {
         player->permissions = 0;
     } else if (reset == 1) {
@@ -281,16 +342,34 @@ void init_player(server_t*  server,
     memset(player->os_info, 0, 255);
 }
 
+void player_prepare_spawn(server_t* server, player_t* player)
+{
+    if (player->team != TEAM_SPECTATOR) {
+        player->hp             = 100;
+        player->grenades       = 3;
+        player->blocks         = 50;
+        player->item           = TOOL_GUN;
+        player->input          = 0;
+        player->move_forward   = 0;
+        player->move_backwards = 0;
+        player->move_left      = 0;
+        player->move_right     = 0;
+        player->jumping        = 0;
+        player->crouching      = 0;
+        player->sneaking       = 0;
+        player->sprinting      = 0;
+        player->primary_fire   = 0;
+        player->secondary_fire = 0;
+        player->alive          = 1;
+        player->reloading      = 0;
+    }
+    set_player_respawn_point(server, player);
+}
+
 void send_joining_data(server_t* server, player_t* player)
 {
-    player_t *receiver, *tmp;
     LOG_INFO("Sending state to %s (#%hhu)", player->name, player->id);
-    HASH_ITER(hh, server->players, receiver, tmp)
-    {
-        if (receiver != player && is_past_join_screen(receiver)) {
-            send_existing_player(server, player, receiver);
-        }
-    }
+    send_existing_players(server, player);
     send_state_data(server, player);
 }
 
@@ -310,26 +389,11 @@ void on_player_update(server_t* server, player_t* player)
             send_joining_data(server, player);
             break;
         case STATE_SPAWNING:
-            if (player->team != TEAM_SPECTATOR) {
-                player->hp             = 100;
-                player->grenades       = 3;
-                player->blocks         = 50;
-                player->item           = TOOL_GUN;
-                player->input          = 0;
-                player->move_forward   = 0;
-                player->move_backwards = 0;
-                player->move_left      = 0;
-                player->move_right     = 0;
-                player->jumping        = 0;
-                player->crouching      = 0;
-                player->sneaking       = 0;
-                player->sprinting      = 0;
-                player->primary_fire   = 0;
-                player->secondary_fire = 0;
-                player->alive          = 1;
-                player->reloading      = 0;
+            if (!gamemode_can_spawn(server, player)) {
+                player->state = STATE_WAITING_FOR_RESPAWN;
+                break;
             }
-            set_player_respawn_point(server, player);
+            player_prepare_spawn(server, player);
             send_respawn(server, player);
             LOG_INFO("Player %s (#%hhu) spawning at: %f %f %f",
                      player->name,
@@ -340,7 +404,9 @@ void on_player_update(server_t* server, player_t* player)
             break;
         case STATE_WAITING_FOR_RESPAWN:
         {
-            if (time(NULL) - player->timers.start_of_respawn_wait >= player->respawn_time) {
+            if (time(NULL) - player->timers.start_of_respawn_wait >= player->respawn_time &&
+                gamemode_can_spawn(server, player))
+            {
                 player->state = STATE_SPAWNING;
             }
             break;
@@ -449,6 +515,9 @@ void on_new_player_connection(server_t* server, ENetEvent* event)
         LOG_WARNING("Server full. Kicking player");
         return;
     }
+    // /undo of this ID must only reach the new player's edits, not those of whoever had it before
+    map_journal_forget(server, player_id);
+
     player_t*  player  = spadesx_calloc(1, sizeof(player_t));
     vector3f_t empty   = {0, 0, 0};
     vector3f_t forward = {1, 0, 0};
@@ -475,7 +544,9 @@ void on_new_player_connection(server_t* server, ENetEvent* event)
     player->periodic_delay_index          = 0;
     player->state                         = STATE_STARTING_MAP;
     HASH_ADD(hh, server->players, id, sizeof(uint8_t), player);
+    server->players_by_id[player->id] = player;
     HASH_SORT(server->players, player_sort);
+    EVENT_RUN(server, player_connect, player);
 }
 
 void for_players(server_t* server)
@@ -513,7 +584,7 @@ void for_players(server_t* server)
                         player->weapon_clip--;
                         if (player->weapon_clip == 0) {
                             player->primary_fire = 0;
-                            send_weapon_input(server, player, 0);
+                            queue_weapon_input(player, 0);
                         }
                     }
                 }
@@ -565,7 +636,7 @@ void for_players(server_t* server)
                 string_node_t* message;
                 DL_FOREACH(server->periodic_messages, message)
                 {
-                    send_server_notice(player, 0, message->string);
+                    send_server_notice(server, player, 0, message->string);
                 }
                 player->periodic_delay_index = fmin(player->periodic_delay_index + 1, 4);
             }
@@ -593,12 +664,10 @@ void for_players(server_t* server)
                 free(node);
             }
         }
-        if (player->state == STATE_READY) {
+        if (player->state == STATE_READY && server->protocol.gamemode_ops->player_update != NULL) {
             uint64_t time_now = get_nanos();
-            if (diff_is_older_then(time_now, &player->timers.since_last_intel_tent_check, NANO_IN_SECOND) &&
-                server->protocol.current_gamemode != GAME_MODE_ARENA)
-            {
-                handleTentAndIntel(server, player);
+            if (diff_is_older_then(time_now, &player->timers.since_last_intel_tent_check, NANO_IN_SECOND)) {
+                server->protocol.gamemode_ops->player_update(server, player);
             }
         }
     }
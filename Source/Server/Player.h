@@ -6,9 +6,12 @@
 void    on_new_player_connection(server_t* server, ENetEvent* event);
 int     player_sort(player_t* a, player_t* b);
 void    free_all_players(server_t* server);
+void    player_free_map_queue(player_t* player);
 void    for_players(server_t* server);
 void    on_player_update(server_t* server, player_t* player);
 void    send_joining_data(server_t* server, player_t* player);
+// Refill and place a player about to be sent a create player packet
+void    player_prepare_spawn(server_t* server, player_t* player);
 void    init_player(server_t*  server,
                     player_t*  player,
                     uint8_t    reset,
@@ -21,5 +24,14 @@ void    set_player_respawn_point(server_t* server, player_t* player);
 uint8_t get_player_unstuck(server_t* server, player_t* player);
 uint8_t is_staff(server_t* server, player_t* player);
 void    update_movement_and_grenades(server_t* server);
+void    queue_weapon_input(player_t* player, uint8_t input);
+void    flush_pending_broadcasts(server_t* server, player_t* player);
+void    player_set_team(server_t* server, player_t* player, uint8_t team);
+void    player_leave_team(server_t* server, player_t* player);
+
+static inline uint8_t team_members_index(uint8_t team)
+{
+    return (team == TEAM_A || team == TEAM_B) ? team : 2;
+}
 
 #endif
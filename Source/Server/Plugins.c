@@ -0,0 +1,274 @@
+#include <Server/Plugins.h>
+#include <Server/Structs/ServerStruct.h>
+#include <Util/Log.h>
+#include <Util/Nanos.h>
+#include <Util/Utlist.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+static void _queue_push(plugin_queue_t* queue, plugin_job_t job)
+{
+    queue->jobs[(queue->head + queue->count) % PLUGIN_QUEUE_SIZE] = job;
+    queue->count++;
+}
+
+static plugin_job_t _queue_pop(plugin_queue_t* queue)
+{
+    plugin_job_t job = queue->jobs[queue->head];
+    queue->head      = (queue->head + 1) % PLUGIN_QUEUE_SIZE;
+    queue->count--;
+    return job;
+}
+
+static void* _plugin_worker(void* arg)
+{
+    plugin_host_t* host = (plugin_host_t*) arg;
+
+    pthread_mutex_lock(&host->lock);
+    while (host->running) {
+        if (host->pending.count == 0) {
+            pthread_cond_wait(&host->wake, &host->lock);
+            continue;
+        }
+        plugin_job_t job = _queue_pop(&host->pending);
+        // Jobs of disabled plugins go straight back to be cancelled
+        if (!job.plugin->disabled) {
+            pthread_mutex_unlock(&host->lock);
+            job.work(job.arg);
+            pthread_mutex_lock(&host->lock);
+        }
+        // Cannot overflow as in_flight never goes over the queue size
+        _queue_push(&host->finished, job);
+    }
+    pthread_mutex_unlock(&host->lock);
+    return NULL;
+}
+
+static void _plugin_unsubscribe_all(server_t* server, plugin_t* plugin)
+{
+    while (plugin->listener_count > 0) {
+        plugin_listener_t* listener = &plugin->listeners[--plugin->listener_count];
+        listener->unsubscribe(server, listener->callback);
+    }
+}
+
+static void _plugin_disable(server_t* server, plugin_t* plugin)
+{
+    plugin_host_t* host = &server->plugins;
+    pthread_mutex_lock(&host->lock);
+    plugin->disabled = 1;
+    pthread_mutex_unlock(&host->lock);
+    _plugin_unsubscribe_all(server, plugin);
+}
+
+static void _plugin_load(server_t* server, const char* path)
+{
+    plugin_host_t* host = &server->plugins;
+    if (host->count >= PLUGIN_MAX) {
+        LOG_WARNING("Only %d plugins can be loaded, skipping %s", PLUGIN_MAX, path);
+        return;
+    }
+
+    void* handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (handle == NULL) {
+        LOG_ERROR("Failed to load plugin %s: %s", path, dlerror());
+        return;
+    }
+
+    plugin_init_fn_t init;
+    *(void**) (&init) = dlsym(handle, "spadesx_plugin_init");
+    if (init == NULL) {
+        LOG_ERROR("Plugin %s does not export spadesx_plugin_init", path);
+        dlclose(handle);
+        return;
+    }
+
+    plugin_t* plugin = &host->plugins[host->count];
+    memset(plugin, 0, sizeof(plugin_t));
+    plugin->handle = handle;
+    *(void**) (&plugin->tick) = dlsym(handle, "spadesx_plugin_tick");
+    *(void**) (&plugin->free) = dlsym(handle, "spadesx_plugin_free");
+
+    const char* name = strrchr(path, '/');
+    snprintf(plugin->name, sizeof(plugin->name), "%s", name == NULL ? path : name + 1);
+
+    // A failing init must not have submitted any jobs
+    if (init(server, plugin) != 0) {
+        LOG_ERROR("Plugin %s failed to initialize", plugin->name);
+        _plugin_unsubscribe_all(server, plugin);
+        dlclose(handle);
+        return;
+    }
+    host->count++;
+    LOG_STATUS("Loaded plugin %s", plugin->name);
+}
+
+void plugins_start(server_t* server, string_node_t* paths, uint64_t budget)
+{
+    plugin_host_t* host = &server->plugins;
+    host->budget        = budget;
+    if (paths == NULL) {
+        return;
+    }
+
+    pthread_mutex_init(&host->lock, NULL);
+    pthread_cond_init(&host->wake, NULL);
+    host->running = 1;
+    if (pthread_create(&host->worker, NULL, _plugin_worker, (void*) host) != 0) {
+        LOG_ERROR("Failed to start the plugin worker, plugins are disabled");
+        host->running = 0;
+        pthread_cond_destroy(&host->wake);
+        pthread_mutex_destroy(&host->lock);
+        return;
+    }
+
+    string_node_t* path;
+    DL_FOREACH(paths, path)
+    {
+        _plugin_load(server, path->string);
+    }
+}
+
+void plugins_update(server_t* server)
+{
+    plugin_host_t* host = &server->plugins;
+    if (host->count == 0) {
+        return;
+    }
+
+    // One budget for everything plugins do on the game thread, starting with the listeners that ran since the last
+    // update
+    uint64_t spent = 0;
+    for (uint8_t i = 0; i < host->count; ++i) {
+        spent += host->plugins[i].time_spent;
+    }
+
+    for (uint8_t i = 0; i < host->count && spent < host->budget; ++i) {
+        plugin_t* plugin = &host->plugins[(host->first_tick + i) % host->count];
+        if (plugin->tick != NULL && !plugin->disabled) {
+            uint64_t before = get_nanos();
+            plugin->tick(server, plugin);
+            uint64_t took = get_nanos() - before;
+            plugin->time_spent += took;
+            spent += took;
+        }
+    }
+    host->first_tick = (host->first_tick + 1) % host->count;
+
+    // Whatever does not fit waits for the next update
+    while (spent < host->budget) {
+        pthread_mutex_lock(&host->lock);
+        if (host->finished.count == 0) {
+            pthread_mutex_unlock(&host->lock);
+            break;
+        }
+        plugin_job_t job = _queue_pop(&host->finished);
+        host->in_flight--;
+        pthread_mutex_unlock(&host->lock);
+
+        uint64_t before = get_nanos();
+        job.done(server, job.arg, job.plugin->disabled);
+        uint64_t took = get_nanos() - before;
+        job.plugin->time_spent += took;
+        spent += took;
+    }
+
+    // Blame the biggest spender. A plugin cannot clear its record by staying under the budget in between, only the
+    // overrun falling out of the window does
+    plugin_t* culprit = NULL;
+    if (spent > host->budget) {
+        for (uint8_t i = 0; i < host->count; ++i) {
+            plugin_t* plugin = &host->plugins[i];
+            if (culprit == NULL || plugin->time_spent > culprit->time_spent) {
+                culprit = plugin;
+            }
+        }
+    }
+    for (uint8_t i = 0; i < host->count; ++i) {
+        plugin_t* plugin   = &host->plugins[i];
+        plugin->overruns   = (plugin->overruns << 1) | (plugin == culprit);
+        plugin->time_spent = 0;
+        if (!plugin->disabled && __builtin_popcountll(plugin->overruns) >= PLUGIN_MAX_OVERRUNS) {
+            _plugin_disable(server, plugin);
+            LOG_WARNING("Plugin %s went over the budget %d times within 64 updates and was disabled",
+                        plugin->name,
+                        PLUGIN_MAX_OVERRUNS);
+        }
+    }
+}
+
+void plugins_stop(server_t* server)
+{
+    plugin_host_t* host = &server->plugins;
+    if (!host->running) {
+        return;
+    }
+
+    pthread_mutex_lock(&host->lock);
+    host->running = 0;
+    pthread_cond_broadcast(&host->wake);
+    pthread_mutex_unlock(&host->lock);
+    pthread_join(host->worker, NULL);
+
+    while (host->finished.count > 0) {
+        plugin_job_t job = _queue_pop(&host->finished);
+        job.done(server, job.arg, job.plugin->disabled);
+    }
+    while (host->pending.count > 0) {
+        plugin_job_t job = _queue_pop(&host->pending);
+        job.done(server, job.arg, 1);
+    }
+    host->in_flight = 0;
+
+    while (host->count > 0) {
+        plugin_t* plugin = &host->plugins[--host->count];
+        if (plugin->free != NULL) {
+            plugin->free(server, plugin);
+        }
+        // Nothing may call into the library once it is closed
+        _plugin_unsubscribe_all(server, plugin);
+        dlclose(plugin->handle);
+    }
+
+    pthread_cond_destroy(&host->wake);
+    pthread_mutex_destroy(&host->lock);
+}
+
+uint8_t plugin_submit(server_t* server, plugin_t* plugin, plugin_work_fn_t work, plugin_done_fn_t done, void* arg)
+{
+    plugin_host_t* host = &server->plugins;
+    if (!host->running || plugin->disabled) {
+        return 1;
+    }
+
+    pthread_mutex_lock(&host->lock);
+    if (host->in_flight >= PLUGIN_QUEUE_SIZE) {
+        pthread_mutex_unlock(&host->lock);
+        return 1;
+    }
+    host->in_flight++;
+    _queue_push(&host->pending, (plugin_job_t) {plugin, work, done, arg});
+    pthread_cond_signal(&host->wake);
+    pthread_mutex_unlock(&host->lock);
+    return 0;
+}
+
+uint8_t plugin_listen(server_t*               server,
+                      plugin_t*               plugin,
+                      uint8_t                 subscribed,
+                      plugin_unsubscribe_fn_t unsubscribe,
+                      plugin_callback_t       callback)
+{
+    if (!subscribed) {
+        return 0;
+    }
+    if (plugin->listener_count == PLUGIN_MAX_LISTENERS) {
+        LOG_WARNING("Plugin %s already has %d listeners", plugin->name, PLUGIN_MAX_LISTENERS);
+        unsubscribe(server, callback);
+        return 0;
+    }
+    plugin->listeners[plugin->listener_count++] = (plugin_listener_t) {unsubscribe, callback};
+    return 1;
+}
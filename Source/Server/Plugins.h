@@ -0,0 +1,69 @@
+#ifndef PLUGINS_H
+#define PLUGINS_H
+
+#include <Server/Structs/PluginStruct.h>
+#include <Server/Structs/ServerStruct.h>
+
+// Overruns within the last 64 updates a plugin is allowed before its tick and pending jobs are dropped
+#define PLUGIN_MAX_OVERRUNS 4
+
+/**
+ * @brief Start the worker thread and load every plugin in the list
+ *
+ * A plugin is a shared library exporting `uint8_t spadesx_plugin_init(server_t*, plugin_t*)`, returning 0 on
+ * success. It may also export `spadesx_plugin_tick` and `spadesx_plugin_free`. Plugins hook into the server by
+ * subscribing to events with PLUGIN_SUBSCRIBE, anything slow has to go through plugin_submit.
+ *
+ * Plugins are native code and cannot be interrupted. The budget is checked between calls into them, so a single call
+ * that runs long still goes over it and one that never returns stalls the server.
+ *
+ * @param budget Nanoseconds all plugins together may spend on the game thread per update, ticks, finished jobs and
+ * event listeners included
+ */
+void plugins_start(server_t* server, string_node_t* paths, uint64_t budget);
+
+/**
+ * @brief Run the plugin ticks and hand finished jobs back, stopping once the budget is used up
+ *
+ * Listener time since the last update counts against the same budget. Ticks that do not fit are skipped and jobs left
+ * over are handed back on the next update. When the budget is overrun the plugin that used the most of it is blamed,
+ * and a plugin blamed PLUGIN_MAX_OVERRUNS times within 64 updates is disabled, which unsubscribes its
+ * listeners and cancels its jobs.
+ */
+void plugins_update(server_t* server);
+
+/**
+ * @brief Stop the worker, cancel queued jobs and unload every plugin
+ */
+void plugins_stop(server_t* server);
+
+/**
+ * @brief Queue work for the worker thread, done is called on the game thread afterwards
+ *
+ * @return 0 when queued, 1 when the plugin is disabled or the queue is full
+ */
+uint8_t plugin_submit(server_t* server, plugin_t* plugin, plugin_work_fn_t work, plugin_done_fn_t done, void* arg);
+
+/**
+ * @brief Remember a subscription of the plugin so it is dropped when the plugin is disabled or unloaded
+ *
+ * Use PLUGIN_SUBSCRIBE rather than calling this directly.
+ *
+ * @param subscribed Result of on_[event]_subscribe_metered, nothing is remembered when it is 0
+ * @return 1 when subscribed, 0 when the event or the plugin has no room for another listener
+ */
+uint8_t plugin_listen(server_t*               server,
+                      plugin_t*               plugin,
+                      uint8_t                 subscribed,
+                      plugin_unsubscribe_fn_t unsubscribe,
+                      plugin_callback_t       callback);
+
+// Subscribe a plugin to an event, see Events.h. Time spent in the callback is charged to the plugin
+#define PLUGIN_SUBSCRIBE(server, plugin, event, callback, position)                                           \
+    plugin_listen((server),                                                                                   \
+                  (plugin),                                                                                   \
+                  on_##event##_subscribe_metered((server), (callback), (position), &(plugin)->time_spent),    \
+                  on_##event##_unsubscribe_any,                                                               \
+                  (plugin_callback_t) (callback))
+
+#endif
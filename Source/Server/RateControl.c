@@ -0,0 +1,65 @@
+#include <Server/RateControl.h>
+#include <Server/Structs/ServerStruct.h>
+#include <Util/Enums.h>
+#include <enet/enet.h>
+
+void rate_control_reset(player_t* player)
+{
+    player->rate_control.last_adjust = 0;
+    player->rate_control.base_rtt    = UINT32_MAX;
+    player->rate_control.ups         = player->ups;
+}
+
+static uint8_t _link_congested(server_t* server, player_t* player)
+{
+    rate_control_config_t* config = &server->rate_control;
+    rate_control_t*        rate   = &player->rate_control;
+    ENetPeer*              peer   = player->peer;
+
+    if (peer->roundTripTime < rate->base_rtt) {
+        rate->base_rtt = peer->roundTripTime;
+    } else if (peer->roundTripTime > rate->base_rtt) {
+        rate->base_rtt++; // Let the base follow the link if its route got longer
+    }
+
+    // Queueing delay is what grows when we send faster than the link drains, absolute RTT is just distance
+    uint32_t queue_delay = peer->roundTripTime - rate->base_rtt;
+    return queue_delay > config->delay_limit || peer->packetLoss > config->loss_limit ||
+           peer->reliableDataInTransit > config->backlog_limit;
+}
+
+void rate_control_update(server_t* server, player_t* player, uint64_t time)
+{
+    rate_control_t* rate    = &player->rate_control;
+    float           ceiling = player->ups;
+
+    if (!server->rate_control.enabled || player->peer == NULL) {
+        rate->ups = ceiling;
+        return;
+    }
+    if (time - rate->last_adjust < RATE_CONTROL_INTERVAL) {
+        return;
+    }
+    rate->last_adjust = time;
+
+    // Config files are validated, but a rate of 0 would divide by zero in the world update so check anyway
+    float floor = server->rate_control.min_ups;
+    if (floor < RATE_CONTROL_MIN_UPS) {
+        floor = RATE_CONTROL_MIN_UPS;
+    }
+    if (floor > ceiling) {
+        floor = ceiling;
+    }
+
+    if (_link_congested(server, player)) {
+        rate->ups *= RATE_CONTROL_DECREASE;
+    } else {
+        rate->ups += ceiling * RATE_CONTROL_INCREASE;
+    }
+
+    if (rate->ups < floor) {
+        rate->ups = floor;
+    } else if (rate->ups > ceiling) {
+        rate->ups = ceiling;
+    }
+}
@@ -0,0 +1,19 @@
+#ifndef RATECONTROL_H
+#define RATECONTROL_H
+
+#include <Server/Structs/ServerStruct.h>
+#include <Util/Enums.h>
+
+// How often the rate of each client is re-evaluated
+#define RATE_CONTROL_INTERVAL (NANO_IN_MILLI * 250)
+// Multiplicative decrease on congestion, additive increase (fraction of the requested ups) otherwise
+#define RATE_CONTROL_DECREASE 0.75f
+#define RATE_CONTROL_INCREASE 0.05f
+// Allowed range of min_ups. Never 0, world updates are spaced by a second divided by the rate
+#define RATE_CONTROL_MIN_UPS 1
+#define RATE_CONTROL_MAX_UPS 300
+
+void rate_control_reset(player_t* player);
+void rate_control_update(server_t* server, player_t* player, uint64_t time);
+
+#endif
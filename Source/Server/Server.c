@@ -1,13 +1,18 @@
 // Copyright DarkNeutrino 2021
 #include <Server/Commands/Commands.h>
+#include <Server/Config.h>
 #include <Server/Console.h>
+#include <Server/Egress.h>
 #include <Server/Gamemodes/Gamemodes.h>
 #include <Server/Map.h>
+#include <Server/NameIndex.h>
 #include <Server/Master.h>
 #include <Server/Packets/Packets.h>
 #include <Server/ParseConvert.h>
 #include <Server/Ping.h>
 #include <Server/Player.h>
+#include <Server/Plugins.h>
+#include <Server/RateControl.h>
 #include <Server/Server.h>
 #include <Server/Structs/GrenadeStruct.h>
 #include <Server/Structs/ServerStruct.h>
@@ -57,51 +62,22 @@ server_t* get_server(void)
     return &server; // Needed when we cant pass Server as argument into function
 }
 
-static void _string_nodes_free(string_node_t* root)
-{
-    string_node_t *el, *tmp;
-    DL_FOREACH_SAFE(root, el, tmp)
-    {
-        free(el->string);
-        DL_DELETE(root, el);
-        free(el);
-    }
-}
-
 static void* _calculate_physics(void)
 {
     server.global_timers.update_time = get_nanos();
     if (server.global_timers.update_time - server.global_timers.last_update_time >= (NANO_60TPS)) {
+        EVENT_RUN(&server, tick_begin, server.global_timers.ticks);
         update_movement_and_grenades(&server);
         server.global_timers.last_update_time = get_nanos();
+        EVENT_RUN(&server, tick_end, server.global_timers.ticks);
+        server.global_timers.ticks++;
     }
     return 0;
 }
 
-static void _server_init(server_t*   server,
-                         uint32_t    connections,
-                         const char* serverName,
-                         const char* team1Name,
-                         const char* team2Name,
-                         const uint8_t*    team1_color,
-                         const uint8_t*    team2_color,
-                         uint8_t     gamemode,
-                         uint8_t     reset)
+static void _server_select_map(server_t* server, uint8_t reset)
 {
-    server->global_timers.update_time = server->global_timers.last_update_time = get_nanos();
-    if (reset == 0) {
-        server->protocol.num_players = 0;
-        server->protocol.max_players = (connections <= 32) ? connections : 32;
-    }
-
-    server->protocol.input_flags  = 0;
-
-    char    vxl_map[64];
     uint8_t index;
-    if (reset == 0) {
-        server->rand = seed_rand(time(NULL));
-    }
-
     // Select map based on rotation mode
     if (server->s_map.rotation_mode == MAP_ROTATION_RANDOM) {
         // Random selection
@@ -143,6 +119,50 @@ static void _server_init(server_t*   server,
             server->s_map.current_map = server->s_map.map_list;
         }
     }
+}
+
+// Both corners of a protected region have to be given in full, a missing one would silently protect from the origin
+static uint8_t _read_protected_corner(toml_table_t* table, const char* name, int index, vector3i_t* corner)
+{
+    toml_array_t* array = toml_array_in(table, name);
+    int           xyz[3];
+    if (array == NULL || toml_array_nelem(array) != 3) {
+        LOG_ERROR("Protected region %d needs %s = [x, y, z], skipping it", index, name);
+        return 0;
+    }
+    for (int i = 0; i < 3; ++i) {
+        toml_datum_t value = toml_int_at(array, i);
+        if (!value.ok) {
+            LOG_ERROR("Protected region %d needs %s = [x, y, z], skipping it", index, name);
+            return 0;
+        }
+        xyz[i] = (int) value.u.i;
+    }
+    corner->x = xyz[0];
+    corner->y = xyz[1];
+    corner->z = xyz[2];
+    return 1;
+}
+
+static void _server_init(server_t*   server,
+                         uint32_t    connections,
+                         const char* serverName,
+                         const char* team1Name,
+                         const char* team2Name,
+                         const uint8_t*    team1_color,
+                         const uint8_t*    team2_color,
+                         uint8_t     gamemode,
+                         uint8_t     reset)
+{
+    server->global_timers.update_time = server->global_timers.last_update_time = get_nanos();
+    if (reset == 0) {
+        server->protocol.num_players = 0;
+        server->protocol.max_players = (connections <= 32) ? connections : 32;
+    }
+
+    server->protocol.input_flags  = 0;
+
+    char vxl_map[64];
     snprintf(
     server->map_name, fmin(strlen(server->s_map.current_map->string) + 1, 20), "%s", server->s_map.current_map->string);
     LOG_STATUS("Selecting %s as map", server->map_name);
@@ -170,6 +190,7 @@ static void _server_init(server_t*   server,
     TOMLH_GET_INT_ARRAY(map_table, fog_color, "fog_color", 3, ((int[]){128, 232, 255}), 1);
     TOMLH_GET_INT_ARRAY(map_table, map_size, "map_size", 3, ((int[]){512, 512, 64}), 1);
     TOMLH_GET_INT(map_table, capture_limit, "capture_limit", server->capture_limit, 1);
+    server->s_map.own_capture_limit = toml_int_in(map_table, "capture_limit").ok;
 
     /* [water_damage] */
     uint8_t water_damage_enabled;
@@ -195,6 +216,39 @@ static void _server_init(server_t*   server,
         return;
     }
 
+    /* [[protected]] */
+    map_protection_clear(server);
+    toml_array_t* protected_array = toml_array_in(parsed, "protected");
+    int           protected_count = protected_array ? toml_array_nelem(protected_array) : 0;
+    int           protected_used  = 0;
+    for (int i = 0; i < protected_count; ++i) {
+        toml_table_t* protected_table = toml_table_at(protected_array, i);
+        vector3i_t    from;
+        vector3i_t    to;
+        if (!protected_table) {
+            LOG_ERROR("Protected region %d is not a table, skipping it", i);
+            continue;
+        }
+        if (!_read_protected_corner(protected_table, "start", i, &from) ||
+            !_read_protected_corner(protected_table, "end", i, &to))
+        {
+            continue;
+        }
+        if (from.x > to.x || from.y > to.y || from.z > to.z) {
+            LOG_ERROR("Protected region %d starts after it ends, skipping it", i);
+            continue;
+        }
+        if (!valid_pos_v3i(server, from) || !valid_pos_v3i(server, to)) {
+            LOG_ERROR("Protected region %d is outside of map limits, skipping it", i);
+            continue;
+        }
+        map_protect_box(server, from, to);
+        protected_used++;
+    }
+    if (protected_used > 0) {
+        LOG_STATUS("Protected %d regions of the map", protected_used);
+    }
+
     vector3i_t team1_start_range = {team1_start[0], team1_start[1], 1};
     vector3i_t team1_end_range   = {team1_end[0], team1_end[1], 1};
     vector3i_t team2_start_range = {team2_start[0], team2_start[1], 1};
@@ -260,9 +314,10 @@ static void _server_init(server_t*   server,
     server->server_name[strlen(serverName)] = '\0';
     toml_free(parsed);
     gamemode_init(server, gamemode);
+    map_snapshot(server);
 }
 
-void server_reset(server_t* server)
+static void _server_reload(server_t* server)
 {
     _server_init(server,
                  server->protocol.max_players,
@@ -275,6 +330,81 @@ void server_reset(server_t* server)
                  1);
 }
 
+void server_reset(server_t* server)
+{
+    _server_select_map(server, 1);
+    _server_reload(server);
+}
+
+static uint8_t _server_soft_reset(server_t* server)
+{
+    block_painter_t painter;
+    if (server->s_map.soft_reset == 0 || !block_painter_init(server, &painter)) {
+        return 0;
+    }
+
+    uint64_t start   = get_nanos();
+    int64_t  changes = map_restore(server, server->s_map.soft_reset_limit, send_restored_block, &painter);
+    if (changes < 0) {
+        return 0;
+    }
+
+    player_t *player, *tmp;
+    HASH_ITER(hh, server->players, player, tmp)
+    {
+        grenade_t *grenade, *tmp_grenade;
+        DL_FOREACH_SAFE(player->grenade, grenade, tmp_grenade)
+        {
+            DL_DELETE(player->grenade, grenade);
+            free(grenade);
+        }
+        player->has_intel = 0;
+        if (is_past_join_screen(player)) {
+            player->state = STATE_SPAWNING;
+        } else if (player->state != STATE_DISCONNECTED && player->state != STATE_PICK_SCREEN) {
+            // Still downloading the old map, start over with the restored one
+            player_free_map_queue(player);
+            player->state = STATE_STARTING_MAP;
+        }
+    }
+
+    gamemode_init(server, server->protocol.current_gamemode);
+    server->global_ab = 1;
+    server->global_ak = 1;
+    map_snapshot(server);
+
+    LOG_STATUS("Soft reset of %s restored %lld blocks in %llu ms",
+               server->map_name,
+               (long long) changes,
+               (unsigned long long) ((get_nanos() - start) / NANO_IN_MILLI));
+    return 1;
+}
+
+void server_round_reset(server_t* server)
+{
+    string_node_t* previous_map = server->s_map.current_map;
+    _server_select_map(server, 1);
+    // No previous map when a config reload dropped the one being played from the rotation
+    if (previous_map != NULL && strcmp(previous_map->string, server->s_map.current_map->string) == 0 &&
+        _server_soft_reset(server))
+    {
+        return;
+    }
+    server_map_reload(server);
+}
+
+void server_map_reload(server_t* server)
+{
+    player_t *player, *tmp;
+    HASH_ITER(hh, server->players, player, tmp)
+    {
+        if (player->state != STATE_DISCONNECTED) {
+            player->state = STATE_STARTING_MAP;
+        }
+    }
+    _server_reload(server);
+}
+
 static void* _world_update(void)
 {
     player_t *player, *tmp;
@@ -283,7 +413,10 @@ static void* _world_update(void)
         on_player_update(&server, player);
         if (is_past_join_screen(player)) {
             uint64_t time = get_nanos();
-            if (time - player->timers.time_since_last_wu >= (uint64_t) (NANO_IN_SECOND / player->ups)) {
+            rate_control_update(&server, player, time);
+            if (time - player->timers.time_since_last_wu >=
+                (uint64_t) (NANO_IN_SECOND / player->rate_control.ups))
+            {
                 send_world_update(&server, player);
                 player->timers.time_since_last_wu = get_nanos();
             }
@@ -316,13 +449,15 @@ static void _server_update(server_t* server, int timeout)
                     }
                     send_intel_drop(server, player);
                     send_player_left(server, player);
+                    name_index_remove(server, player);
+                    player_leave_team(server, player);
+                    gamemode_player_leave(server, player);
                     vector3f_t empty   = {0, 0, 0};
                     vector3f_t forward = {1, 0, 0};
                     vector3f_t height  = {0, 0, 1};
                     vector3f_t strafe  = {0, 1, 0};
                     init_player(server, player, 0, 1, empty, forward, strafe, height);
                     server->protocol.num_players--;
-                    server->protocol.num_team_users[player->team]--;
                     if (server->master.enable_master_connection == 1) {
                         master_update(server);
                     }
@@ -330,6 +465,7 @@ static void _server_update(server_t* server, int timeout)
                     uint32_t   counter = 0;
                     DL_COUNT(player->grenade, elt, counter);
                     if (counter == 0) {
+                        server->players_by_id[player->id] = NULL;
                         HASH_DEL(server->players, player);
                         HASH_SORT(server->players, player_sort);
                         free(player);
@@ -390,6 +526,9 @@ static void _handle_signal(const int sig)
         case SIGTERM:
             stop_server();
             break;
+        case SIGHUP:
+            config_request_reload(&server);
+            break;
         default:
             LOG_ERROR("Received unhandled signal %d", sig);
             break;
@@ -405,6 +544,7 @@ static inline void _apply_signal_handlers(void)
 
     _set_sigaction(SIGINT, &sigact, "SIGINT");
     _set_sigaction(SIGTERM, &sigact, "SIGTERM");
+    _set_sigaction(SIGHUP, &sigact, "SIGHUP");
 }
 
 void server_start(server_args args)
@@ -447,6 +587,7 @@ void server_start(server_args args)
     LOG_STATUS("Intializing server");
     server.players                = NULL;
     server.running                = 1;
+    server.config                 = args.config;
     server.s_map.map_list         = args.map_list;
     server.s_map.map_count        = args.map_count;
     server.s_map.rotation_mode    = args.map_rotation_mode;
@@ -456,6 +597,14 @@ void server_start(server_args args)
     server.periodic_message_count = args.periodic_message_list_len;
     server.periodic_delays        = args.periodic_delays;
     server.capture_limit          = args.capture_limit;
+    server.rate_control           = args.rate_control;
+    server.egress.rate            = args.egress_bandwidth * 1024;
+    server.egress.peer_rate       = args.egress_peer_bandwidth * 1024;
+    server.egress.last_refill     = get_nanos();
+    server.s_map.soft_reset       = args.soft_reset;
+    server.s_map.soft_reset_limit = args.soft_reset_limit;
+    server.rand                   = seed_rand(time(NULL));
+    _server_select_map(&server, 0);
     _server_init(&server,
                  args.connections,
                  args.server_name,
@@ -468,6 +617,7 @@ void server_start(server_args args)
 
     command_populate_all(&server);
     init_packets(&server);
+    name_filter_init(&server);
 
     server.master.enable_master_connection = args.master;
     server.manager_passwd                  = args.manager_password;
@@ -476,6 +626,8 @@ void server_start(server_args args)
     server.guard_passwd                    = args.guard_password;
     server.trusted_passwd                  = args.trusted_password;
 
+    plugins_start(&server, args.plugin_list, (uint64_t) args.plugin_budget * 1000);
+
     if (server.running) {
         LOG_STATUS("Server started");
     }
@@ -497,10 +649,14 @@ void server_start(server_args args)
 
     while (server.running) {
         pthread_mutex_lock(&server_lock);
+        config_update(&server);
         _calculate_physics();
         _server_update(&server, 0);
         _world_update();
+        gamemode_tick(&server);
+        plugins_update(&server);
         for_players(&server);
+        egress_flush(&server);
         pthread_mutex_unlock(&server_lock);
         sleep(0);
     }
@@ -512,15 +668,19 @@ void server_start(server_args args)
         enet_peer_disconnect_now(player->peer, REASON_KICKED);
     }
 
+    plugins_stop(&server);
     free_all_commands(&server);
     free_all_packets(&server);
+    LOG_INFO("Egress: %llu packets deferred, %llu chat packets dropped",
+             (unsigned long long) server.egress.deferred,
+             (unsigned long long) server.egress.dropped);
     free_all_players(&server);
+    gamemode_free(&server);
 
-    _string_nodes_free(server.welcome_messages);
-    _string_nodes_free(server.s_map.map_list);
-    _string_nodes_free(server.periodic_messages);
+    config_stop(&server);
+    config_free(server.config);
 
-    mapvxl_free(&server.s_map.map);
+    map_free(&server);
 
     pthread_mutex_destroy(&server_lock);
 
@@ -30,4 +30,19 @@ void server_start(server_args args);
 
 void server_reset(server_t* server);
 
+/**
+ * @brief End the round, keeping everyone connected when the next map is the one being played
+ *
+ * With soft resets enabled only the edited voxels are restored and sent to the clients, who then respawn. Otherwise
+ * every player downloads the next map again like with server_reset.
+ */
+void server_round_reset(server_t* server);
+
+/**
+ * @brief Send every player the map being played again, as it was when it was loaded. The rotation does not move on
+ *
+ * The gamemode starts over, callers that want to keep any of its state have to carry it across.
+ */
+void server_map_reload(server_t* server);
+
 #endif /* SERVER_H */
@@ -23,13 +23,13 @@ void send_message_to_staff(server_t* server, const char* format, ...)
     va_end(args);
 
     player_t* null_player = NULL;
-    send_server_notice(null_player, 1, fMessage);
+    send_server_notice(server, null_player, 1, fMessage);
 
     player_t *connected_player, *tmp;
     HASH_ITER(hh, server->players, connected_player, tmp)
     {
         if (is_past_join_screen(connected_player) && is_staff(server, connected_player)) {
-            send_server_notice(connected_player, 0, fMessage);
+            send_server_notice(server, connected_player, 0, fMessage);
         }
     }
 }
@@ -2,7 +2,9 @@
 #define COMMANDSTRUCT_H
 
 #include <Util/Types.h>
-#include <Util/Uthash.h>
+
+#define COMMAND_TABLE_SIZE  128 // Slots of the command lookup table, must be a power of two
+#define COMMAND_TABLE_SEEDS 64  // Buckets with their own hash seed, must be a power of two
 
 typedef struct player player_t;
 typedef struct server server_t;
@@ -21,7 +23,7 @@ typedef struct command_args
     uint8_t   console;
     uint32_t  permissions;
     uint32_t  argc;
-    char*     argv[32]; // 32 roles commands should be more than enough for anyone
+    char*     argv[32]; // Point into the message, 32 arguments should be more than enough for anyone
 } command_args_t;
 
 typedef struct command
@@ -32,10 +34,16 @@ typedef struct command
     void (*execute)(void* p_server, command_args_t arguments);
     uint32_t        permissions; // 32 roles should be more then enough for anyone
     char            description[1024];
-    UT_hash_handle  hh;
     struct command* next;
 } command_t;
 
+// Perfect hash built whenever the commands change, see _command_table_build
+typedef struct command_table
+{
+    command_t* slots[COMMAND_TABLE_SIZE];
+    uint16_t   seeds[COMMAND_TABLE_SEEDS]; // 0 when no command falls into the bucket
+} command_table_t;
+
 // Command but with removed hash map and linked list stuff for easy managment
 typedef struct command_manager
 {
@@ -0,0 +1,59 @@
+#ifndef CONFIGSTRUCT_H
+#define CONFIGSTRUCT_H
+
+#include <Server/Structs/MapStruct.h>
+#include <Server/Structs/RateControlStruct.h>
+#include <Util/Types.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdint.h>
+
+// Everything read from config.toml. A snapshot is never changed after loading, reloads build a new one.
+typedef struct config
+{
+    string_node_t*        map_list;
+    string_node_t*        welcome_messages;
+    string_node_t*        periodic_messages;
+    string_node_t*        plugin_list;
+    char*                 server_name;
+    char*                 team1_name;
+    char*                 team2_name;
+    char*                 manager_password;
+    char*                 admin_password;
+    char*                 mod_password;
+    char*                 guard_password;
+    char*                 trusted_password;
+    color_t               team1_color;
+    color_t               team2_color;
+    rate_control_config_t rate_control;
+    map_rotation_mode_t   rotation_mode;
+    uint32_t              egress_bandwidth;
+    uint32_t              egress_peer_bandwidth;
+    uint32_t              soft_reset_limit;
+    uint32_t              plugin_budget;
+    uint16_t              port;
+    uint8_t               periodic_delays[5];
+    uint8_t               master;
+    uint8_t               gamemode;
+    uint8_t               capture_limit;
+    uint8_t               soft_reset;
+    uint8_t               map_count;
+    uint8_t               welcome_message_count;
+    uint8_t               periodic_message_count;
+} config_t;
+
+typedef enum config_reload_state {
+    CONFIG_RELOAD_IDLE    = 0,
+    CONFIG_RELOAD_LOADING = 1, // The loader thread is parsing the file
+    CONFIG_RELOAD_DONE    = 2, // pending holds the result, NULL if the file was rejected
+} config_reload_state_t;
+
+typedef struct config_reload
+{
+    config_t*             pending;
+    pthread_t             loader;    // Joined once it is done, valid while the state is not idle
+    volatile sig_atomic_t requested; // Set by SIGHUP and /reload, picked up by the game thread
+    uint8_t               state;     // config_reload_state_t, shared with the loader thread
+} config_reload_t;
+
+#endif
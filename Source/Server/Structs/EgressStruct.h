@@ -0,0 +1,42 @@
+#ifndef EGRESSSTRUCT_H
+#define EGRESSSTRUCT_H
+
+#include <enet/enet.h>
+#include <stdint.h>
+
+#define EGRESS_QUEUE_SIZE 64 // Must be a power of two
+
+// Lower value wins. Gameplay state is never queued, map chunks are pulled from the player's map queue.
+typedef enum egress_class {
+    EGRESS_GAMEPLAY = 0,
+    EGRESS_BLOCK    = 1,
+    EGRESS_CHAT     = 2,
+    EGRESS_MAP      = 3,
+} egress_class_t;
+
+#define EGRESS_QUEUED_CLASSES 2 // EGRESS_BLOCK and EGRESS_CHAT
+
+typedef struct egress_queue
+{
+    ENetPacket* packets[EGRESS_QUEUE_SIZE];
+    uint8_t     head;
+    uint8_t     count;
+} egress_queue_t;
+
+typedef struct egress_peer
+{
+    egress_queue_t queues[EGRESS_QUEUED_CLASSES];
+    int64_t        tokens;
+} egress_peer_t;
+
+typedef struct egress
+{
+    uint32_t rate;      // Bytes per second for the whole server, 0 is unlimited
+    uint32_t peer_rate; // Bytes per second for a single player, 0 is unlimited
+    int64_t  tokens;
+    uint64_t last_refill;
+    uint64_t deferred; // Packets that had to wait for budget
+    uint64_t dropped;  // Chat packets dropped because the queue of a player was full
+} egress_t;
+
+#endif
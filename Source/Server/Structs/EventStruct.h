@@ -3,11 +3,19 @@
 
 #include <Server/Events.h>
 
-#define EVENT_HANDLERS_LIST(event) event##Listener_t* event
+#define EVENT_HANDLERS_LIST(event) event##Listeners_t event
 
 typedef struct event_handlers
 {
+    EVENT_HANDLERS_LIST(player_connect);
     EVENT_HANDLERS_LIST(player_disconnect);
+    EVENT_HANDLERS_LIST(player_spawn);
+    EVENT_HANDLERS_LIST(player_kill);
+    EVENT_HANDLERS_LIST(block_change);
+    EVENT_HANDLERS_LIST(grenade_explode);
+    EVENT_HANDLERS_LIST(chat);
+    EVENT_HANDLERS_LIST(tick_begin);
+    EVENT_HANDLERS_LIST(tick_end);
 } event_handlers_t;
 
 #endif
@@ -1,9 +1,50 @@
 #ifndef GAMEMODESTRUCT_H
 #define GAMEMODESTRUCT_H
 
+#include <Server/Structs/PlayerStruct.h>
 #include <Util/Enums.h>
 #include <Util/Types.h>
 
+typedef struct server server_t;
+
+// Territory control, up to 16 territories fit in the state data
+#define TC_MAX_TERRITORIES 16
+#define TC_TEAM_NEUTRAL    2
+
+typedef struct territory
+{
+    vector3f_t position;
+    uint8_t    team;       // Owner, TEAM_A, TEAM_B or TC_TEAM_NEUTRAL
+    uint8_t    players[2]; // Living players of each team inside, kept up to date as players move
+    int8_t     rate;       // Rate the clients were last told about, positive towards team B
+    float      progress;   // 0 is owned by team A, 1 by team B
+} territory_t;
+
+typedef struct territory_control
+{
+    territory_t territories[TC_MAX_TERRITORIES];
+    uint8_t     count;
+    uint8_t*    grid; // Per column 1 + the territory it lies in, 0 outside of all of them
+    int         size_x;
+    int         size_y;
+    uint64_t    last_update;
+} territory_control_t;
+
+typedef enum arena_state
+{
+    ARENA_WAITING,   // Not enough players, everybody respawns as usual
+    ARENA_COUNTDOWN, // Both teams have players, the round starts shortly
+    ARENA_PLAYING,   // Nobody respawns until one team is wiped out
+    ARENA_ENDING     // Round is over, the next one starts shortly
+} arena_state_t;
+
+typedef struct arena
+{
+    arena_state_t state;
+    uint64_t      state_since;
+    uint64_t      last_check_tick;
+} arena_t;
+
 typedef struct gamemode_vars
 {
     uint8_t      score[2];
@@ -16,6 +57,25 @@ typedef struct gamemode_vars
     // water damage
     uint8_t      water_damage_enabled;
     uint8_t      water_damage;
+    // territory control
+    territory_control_t tc;
+    // arena
+    arena_t arena;
 } gamemode_vars_t;
 
+// Hooks of one gamemode. Hooks a mode has no use for are left NULL and are never called
+typedef struct gamemode_ops
+{
+    const char* name;
+    void (*init)(server_t* server);
+    void (*free)(server_t* server);                            // Before the next init and on shutdown
+    void (*tick)(server_t* server);                            // Every iteration of the main loop
+    void (*player_update)(server_t* server, player_t* player); // Once a second for every ready player
+    void (*player_move)(server_t* server, player_t* player);   // Every physics tick for every player
+    void (*player_leave)(server_t* server, player_t* player);  // The player disconnected
+    uint8_t (*can_spawn)(server_t* server, player_t* player);  // Dead and joining players wait while this is 0
+    void (*block_built)(server_t* server);
+    void (*block_destroyed)(server_t* server);
+} gamemode_ops_t;
+
 #endif
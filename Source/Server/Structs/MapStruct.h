@@ -20,15 +20,74 @@ typedef struct string_node
     struct string_node *next, *prev;
 } string_node_t;
 
+// Copy-on-write snapshot of the map, only columns written to since it was taken are copied
+typedef struct map_snapshot
+{
+    uint32_t* slots;   // Per column, 0 when untouched otherwise 1 + the slot holding its pristine copy
+    uint32_t* columns; // Column saved in each slot
+    uint32_t* colors;  // size_z entries per slot
+    uint8_t*  solid;   // size_z entries per slot
+    uint32_t  count;
+    uint32_t  capacity;
+    int       size_x;
+    int       size_y;
+    int       size_z;
+    uint8_t   broken; // A column could not be saved, the snapshot cannot be restored
+} map_snapshot_t;
+
+// Edits kept for /undo, must be a power of two. 20 bytes each
+#define MAP_JOURNAL_SIZE  65536
+#define MAP_EDITOR_SERVER 0xFF
+
+typedef enum map_edit_flags
+{
+    MAP_EDIT_WAS_SOLID = 1,
+    MAP_EDIT_IS_SOLID  = 2,
+    MAP_EDIT_UNDONE    = 4
+} map_edit_flags_t;
+
+typedef struct map_edit
+{
+    uint16_t x;
+    uint16_t y;
+    uint8_t  z;
+    uint8_t  editor; // Player id or MAP_EDITOR_SERVER
+    uint8_t  flags;
+    uint32_t old_color;
+    uint32_t new_color;
+    uint32_t tick; // Physics tick of the edit
+} map_edit_t;
+
+// Ring buffer of the latest edits, older ones are overwritten
+typedef struct map_journal
+{
+    map_edit_t* edits;
+    uint32_t    head; // Edits written so far, the next one goes to head % MAP_JOURNAL_SIZE
+} map_journal_t;
+
+// Voxels no player may build on or break, one bit per z level of every column
+typedef struct map_protection
+{
+    uint64_t* columns; // NULL while nothing is protected
+    int       size_x;
+    int       size_y;
+} map_protection_t;
+
 typedef struct map
 {
     uint8_t        map_count;
     string_node_t* current_map;
-    vector3i_t     result_line[50];
     size_t         map_size;
     mapvxl_t       map;
+    map_snapshot_t snapshot; // Map as it was when the round started
+    map_journal_t  journal;
+    map_protection_t protection;
+    char           path[64];
     string_node_t* map_list;
     map_rotation_mode_t rotation_mode;
+    uint8_t        soft_reset;
+    uint32_t       soft_reset_limit;
+    uint8_t        own_capture_limit; // The map's TOML sets capture_limit, config reloads leave the limit alone
 } map_t;
 
 typedef struct map_node
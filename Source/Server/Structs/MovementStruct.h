@@ -3,6 +3,9 @@
 
 #include <Util/Types.h>
 
+// About one second of history at 60 TPS, must be a power of two
+#define MOVEMENT_HISTORY_SIZE 64
+
 typedef struct movement
 {
     vector3f_t position;
@@ -16,6 +19,20 @@ typedef struct movement
     vector3f_t previous_orientation;
 } movement_t;
 
+typedef struct movement_snapshot
+{
+    uint64_t   time;
+    vector3f_t position;
+    vector3f_t forward_orientation;
+} movement_snapshot_t;
+
+typedef struct movement_history
+{
+    movement_snapshot_t snapshots[MOVEMENT_HISTORY_SIZE];
+    uint8_t             head; // Next slot to be written
+    uint8_t             count;
+} movement_history_t;
+
 typedef struct orientation
 {
     vector3f_t forward;
@@ -0,0 +1,17 @@
+#ifndef NAMEINDEXSTRUCT_H
+#define NAMEINDEXSTRUCT_H
+
+#include <stdint.h>
+
+#define NAME_INDEX_SIZE    64 // Must be a power of two and larger than PLAYER_SLOTS
+#define NAME_FILTER_STATES 64 // Nodes of the unwanted name automaton, the root included
+
+typedef struct name_index
+{
+    uint8_t slots[NAME_INDEX_SIZE]; // Player id + 1 by hash of the folded name, 0 is free
+    // Aho-Corasick automaton over the unwanted words with every failure link already followed
+    uint8_t filter[NAME_FILTER_STATES][256];
+    uint8_t filter_match[NAME_FILTER_STATES]; // Reaching the state means an unwanted word was found
+} name_index_t;
+
+#endif
@@ -4,20 +4,32 @@
 #include <Server/Structs/PlayerStruct.h>
 #include <Util/DataStream.h>
 #include <Util/Types.h>
-#include <Util/Uthash.h>
+
+// Packet ids are a single byte
+#define PACKET_TABLE_SIZE 256
 
 typedef struct server server_t;
 
 typedef struct packet
 {
-    int id;
     void (*packet)(server_t* server, player_t* player, stream_t* data);
-    UT_hash_handle hh;
+    uint32_t min_length; // Including the packet id
+    uint64_t received;
+    uint64_t rejected;
 } packet_t;
 
+// Sends map edits the server makes on its own, see block_painter_init
+typedef struct block_painter
+{
+    uint8_t  player_id;
+    uint8_t  painting;
+    uint32_t color;
+} block_painter_t;
+
 typedef struct packet_manager
 {
-    int id;
+    int      id;
+    uint32_t min_length;
     void (*packet)(server_t* server, player_t* player, stream_t* data);
 } packet_manager_t;
 
@@ -3,10 +3,12 @@
 
 #include <Server/Structs/BlockStruct.h>
 #include <Server/Structs/CommandStruct.h>
+#include <Server/Structs/EgressStruct.h>
 #include <Server/Structs/GrenadeStruct.h>
 #include <Server/Structs/IPStruct.h>
 #include <Server/Structs/MapStruct.h>
 #include <Server/Structs/MovementStruct.h>
+#include <Server/Structs/RateControlStruct.h>
 #include <Server/Structs/TimerStruct.h>
 #include <Util/Enums.h>
 #include <Util/Queue.h>
@@ -16,6 +18,13 @@
 #include <stdint.h>
 
 #define PLAYER_NAME_STRLEN 16
+#define PLAYER_SLOTS       32 // Player ids are always below this, see server_t.players_by_id
+
+// State changes that are rebroadcast once per tick with the latest value instead of once per received packet
+#define PLAYER_PENDING_INPUT_DATA   (1 << 0)
+#define PLAYER_PENDING_WEAPON_INPUT (1 << 1)
+#define PLAYER_PENDING_SET_TOOL     (1 << 2)
+#define PLAYER_PENDING_SET_COLOR    (1 << 3)
 
 typedef struct player
 {
@@ -45,7 +54,9 @@ typedef struct player
     ip_t                     ip;
     vector3f_t               locAtClick;
     movement_t               movement;
-    vector3i_t               result_line[50];
+    movement_history_t       movement_history;
+    rate_control_t           rate_control;
+    egress_peer_t            egress;
     uint16_t                 ups;
     char                     client;
     uint8_t                  id;
@@ -83,7 +94,12 @@ typedef struct player
     uint8_t                  airborne;
     uint8_t                  wade;
     uint8_t                  next_shot_invalid;
+    uint8_t                  pending_broadcasts;
+    uint8_t                  pending_weapon_input;
+    uint8_t                  territory;      // 1 + the territory the player is counted in, 0 when in none
+    uint8_t                  territory_team; // Team the player is counted for in that territory
     char                     name[PLAYER_NAME_STRLEN + 1];
+    char                     folded_name[PLAYER_NAME_STRLEN + 1]; // Lowercase name the player is indexed under
     char                     os_info[255];
 } player_t;
 
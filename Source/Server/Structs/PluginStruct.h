@@ -0,0 +1,77 @@
+#ifndef PLUGINSTRUCT_H
+#define PLUGINSTRUCT_H
+
+#include <pthread.h>
+#include <stdint.h>
+
+#define PLUGIN_MAX           16
+#define PLUGIN_MAX_LISTENERS 16  // Event subscriptions one plugin can have at once
+#define PLUGIN_QUEUE_SIZE    256 // Jobs that can be waiting or finished at once
+
+typedef struct server server_t;
+typedef struct plugin plugin_t;
+
+// Runs on the worker thread without the server lock, must not touch the server
+typedef void (*plugin_work_fn_t)(void* arg);
+// Runs on the game thread once the work is done. Cancelled jobs are not wanted anymore and should only clean up.
+typedef void (*plugin_done_fn_t)(server_t* server, void* arg, uint8_t cancelled);
+
+typedef uint8_t (*plugin_init_fn_t)(server_t* server, plugin_t* plugin);
+typedef void (*plugin_tick_fn_t)(server_t* server, plugin_t* plugin);
+typedef void (*plugin_free_fn_t)(server_t* server, plugin_t* plugin);
+
+// Event callback with its type erased and the on_[event]_unsubscribe_any it came with, see Events.h
+typedef void (*plugin_callback_t)(void);
+typedef void (*plugin_unsubscribe_fn_t)(server_t* server, plugin_callback_t callback);
+
+typedef struct plugin_listener
+{
+    plugin_unsubscribe_fn_t unsubscribe;
+    plugin_callback_t       callback;
+} plugin_listener_t;
+
+typedef struct plugin
+{
+    void*             handle;
+    plugin_tick_fn_t  tick;
+    plugin_free_fn_t  free;
+    void*             data;       // Owned by the plugin
+    plugin_listener_t listeners[PLUGIN_MAX_LISTENERS];
+    uint64_t          time_spent; // Nanoseconds spent on the game thread since the last update, events included
+    uint64_t          overruns;   // One bit per update of the last 64, set when the plugin was blamed for an overrun
+    uint8_t           listener_count;
+    uint8_t           disabled; // Written under the host lock, the worker reads it
+    char              name[32];
+} plugin_t;
+
+typedef struct plugin_job
+{
+    plugin_t*        plugin;
+    plugin_work_fn_t work;
+    plugin_done_fn_t done;
+    void*            arg;
+} plugin_job_t;
+
+typedef struct plugin_queue
+{
+    plugin_job_t jobs[PLUGIN_QUEUE_SIZE];
+    uint16_t     head;
+    uint16_t     count;
+} plugin_queue_t;
+
+typedef struct plugin_host
+{
+    plugin_t        plugins[PLUGIN_MAX];
+    plugin_queue_t  pending;  // Waiting for the worker
+    plugin_queue_t  finished; // Waiting for the game thread
+    pthread_mutex_t lock;
+    pthread_cond_t  wake;
+    pthread_t       worker;
+    uint64_t        budget;    // Nanoseconds all plugins together may spend on the game thread per update
+    uint16_t        in_flight; // Jobs submitted but not yet handed back, never more than PLUGIN_QUEUE_SIZE
+    uint8_t         count;
+    uint8_t         first_tick; // Plugin whose tick runs first, rotates so a used up budget skips everyone in turn
+    uint8_t         running;
+} plugin_host_t;
+
+#endif
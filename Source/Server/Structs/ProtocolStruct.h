@@ -8,6 +8,8 @@ typedef struct protocol
 {
     uint8_t num_users;
     uint8_t num_team_users[256];
+    // Bitmask of player ids in team A, team B and spectators. Kept in sync by player_set_team
+    uint32_t team_members[3];
     //
     uint8_t num_players;
     uint8_t max_players;
@@ -15,8 +17,9 @@ typedef struct protocol
     color_t         color_fog;
     color_t         color_team[2];
     char            name_team[2][11];
-    gamemode_t      current_gamemode;
-    gamemode_vars_t gamemode;
+    gamemode_t            current_gamemode;
+    const gamemode_ops_t* gamemode_ops;
+    gamemode_vars_t       gamemode;
     // respawn area
     quad3d_t spawns[2];
     uint32_t input_flags;
@@ -0,0 +1,22 @@
+#ifndef RATECONTROLSTRUCT_H
+#define RATECONTROLSTRUCT_H
+
+#include <stdint.h>
+
+typedef struct rate_control_config
+{
+    uint8_t  enabled;
+    uint16_t min_ups;       // Never go below this, even on a congested link
+    uint32_t delay_limit;   // Milliseconds of RTT above the link's base RTT before backing off
+    uint32_t loss_limit;    // Packet loss in ENET_PEER_PACKET_LOSS_SCALE units before backing off
+    uint32_t backlog_limit; // Reliable bytes in flight before backing off
+} rate_control_config_t;
+
+typedef struct rate_control
+{
+    uint64_t last_adjust;
+    uint32_t base_rtt; // Lowest RTT seen on this link, drifts up slowly to follow route changes
+    float    ups;      // Current world update rate, between min_ups and the player's requested ups
+} rate_control_t;
+
+#endif
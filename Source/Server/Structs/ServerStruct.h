@@ -1,12 +1,17 @@
 #ifndef SERVERSTRUCT_H
 #define SERVERSTRUCT_H
 
+#include <Server/Structs/ConfigStruct.h>
+#include <Server/Structs/EgressStruct.h>
 #include <Server/Structs/EventStruct.h>
 #include <Server/Structs/MasterStruct.h>
+#include <Server/Structs/NameIndexStruct.h>
 #include <Server/Structs/PacketStruct.h>
 #include <Server/Structs/PhysicsStruct.h>
 #include <Server/Structs/PlayerStruct.h>
+#include <Server/Structs/PluginStruct.h>
 #include <Server/Structs/ProtocolStruct.h>
+#include <Server/Structs/RateControlStruct.h>
 #include <Server/Structs/TimerStruct.h>
 #include <Util/MersenneTwister/MT.h>
 #include <Util/Types.h>
@@ -16,15 +21,22 @@ typedef struct server
 {
     ENetHost*             host;
     player_t*             players;
+    player_t*             players_by_id[PLAYER_SLOTS]; // Mirrors the players hash
     protocol_t            protocol;
     master_t              master;
-    packet_t*             packets;
+    packet_t              packets[PACKET_TABLE_SIZE];
     physics_t             physics;
+    rate_control_config_t rate_control;
+    egress_t              egress;
+    config_t*             config; // Current snapshot, swapped by config_update
+    config_reload_t       config_reload;
+    name_index_t          names;
+    plugin_host_t         plugins;
     mt_rand_t             rand;
     uint16_t              port;
     map_t                 s_map;
     global_timers_t       global_timers;
-    command_t*            cmds_map;
+    command_table_t       cmds_table;
     command_t*            cmds_list;
     string_node_t*        welcome_messages;
     uint8_t               welcome_messages_count;
@@ -1,13 +1,16 @@
 #ifndef STARTSTRUCT_H
 #define STARTSTRUCT_H
 
+#include <Server/Structs/ConfigStruct.h>
 #include <Server/Structs/MapStruct.h>
+#include <Server/Structs/RateControlStruct.h>
 
 typedef struct server_args
 {
     string_node_t* map_list;
     string_node_t* welcome_message_list;
     string_node_t* periodic_message_list;
+    string_node_t* plugin_list;
     uint8_t*       periodic_delays;
     const char*    manager_password;
     const char*    admin_password;
@@ -23,6 +26,10 @@ typedef struct server_args
     uint32_t       channels;
     uint32_t       in_bandwidth;
     uint32_t       out_bandwidth;
+    uint32_t       egress_bandwidth;
+    uint32_t       egress_peer_bandwidth;
+    uint32_t       soft_reset_limit;
+    uint32_t       plugin_budget; // Microseconds
     uint16_t       port;
     uint8_t master;
     uint8_t map_count;
@@ -30,7 +37,10 @@ typedef struct server_args
     uint8_t periodic_message_list_len;
     uint8_t gamemode;
     uint8_t capture_limit;
+    uint8_t soft_reset;
     map_rotation_mode_t map_rotation_mode;
+    rate_control_config_t rate_control;
+    config_t*             config; // Snapshot the strings and lists above point into, owned by the server
 } server_args;
 
 #endif
@@ -34,6 +34,7 @@ typedef struct global_timers
     uint64_t last_update_time;
     uint64_t time_since_start;
     float    time_since_start_simulated;
+    uint32_t ticks; // Physics updates since start
 } global_timers_t;
 
 #endif
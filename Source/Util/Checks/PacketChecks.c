@@ -1,3 +1,4 @@
+#include <Server/Egress.h>
 #include <Server/Structs/ServerStruct.h>
 #include <Util/Checks/PlayerChecks.h>
 #include <Util/Uthash.h>
@@ -9,7 +10,7 @@ uint8_t send_packet_except_sender(server_t* server, ENetPacket* packet, player_t
     HASH_ITER(hh, server->players, player, tmp)
     {
         if (sender->id != player->id && is_past_state_data(player)) {
-            if (enet_peer_send(player->peer, 0, packet) == 0) {
+            if (egress_send(server, player, packet, EGRESS_GAMEPLAY) == 0) {
                 sent = 1;
             }
         }
@@ -25,7 +26,7 @@ uint8_t send_packet_except_sender_dist_check(server_t* server, ENetPacket* packe
     {
         if (sender->id != player->id && is_past_state_data(player)) {
             if (player_to_player_visibile(sender, player) || player->team == TEAM_SPECTATOR) {
-                if (enet_peer_send(player->peer, 0, packet) == 0) {
+                if (egress_send(server, player, packet, EGRESS_GAMEPLAY) == 0) {
                     sent = 1;
                 }
             }
@@ -42,7 +43,7 @@ uint8_t send_packet_dist_check(server_t* server, ENetPacket* packet, player_t* p
     {
         if (is_past_state_data(receiver)) {
             if (player_to_player_visibile(player, receiver) || receiver->team == TEAM_SPECTATOR) {
-                if (enet_peer_send(receiver->peer, 0, packet) == 0) {
+                if (egress_send(server, receiver, packet, EGRESS_GAMEPLAY) == 0) {
                     sent = 1;
                 }
             }
@@ -39,20 +39,16 @@ uint8_t stream_read_u8(stream_t* stream)
 uint16_t stream_read_u16(stream_t* stream)
 {
     ACCESS_CHECK(stream, 2);
-    uint16_t value = 0;
-    value |= ((uint16_t) stream->data[stream->pos++]);
-    value |= ((uint16_t) stream->data[stream->pos++]) << 8;
+    uint16_t value = stream_load_u16(stream->data + stream->pos);
+    stream->pos += 2;
     return value;
 }
 
 uint32_t stream_read_u32(stream_t* stream)
 {
     ACCESS_CHECK(stream, 4);
-    uint32_t value = 0;
-    value |= ((uint32_t) stream->data[stream->pos++]);
-    value |= ((uint32_t) stream->data[stream->pos++]) << 8;
-    value |= ((uint32_t) stream->data[stream->pos++]) << 16;
-    value |= ((uint32_t) stream->data[stream->pos++]) << 24;
+    uint32_t value = stream_load_u32(stream->data + stream->pos);
+    stream->pos += 4;
     return value;
 }
 
@@ -118,17 +114,15 @@ void stream_write_u8(stream_t* stream, uint8_t value)
 void stream_write_u16(stream_t* stream, uint16_t value)
 {
     ACCESS_CHECK_N(stream, 2);
-    stream->data[stream->pos++] = (uint8_t) value;
-    stream->data[stream->pos++] = (uint8_t) (value >> 8);
+    stream_store_u16(stream->data + stream->pos, value);
+    stream->pos += 2;
 }
 
 void stream_write_u32(stream_t* stream, uint32_t value)
 {
     ACCESS_CHECK_N(stream, 4);
-    stream->data[stream->pos++] = (uint8_t) value;
-    stream->data[stream->pos++] = (uint8_t) (value >> 8);
-    stream->data[stream->pos++] = (uint8_t) (value >> 16);
-    stream->data[stream->pos++] = (uint8_t) (value >> 24);
+    stream_store_u32(stream->data + stream->pos, value);
+    stream->pos += 4;
 }
 
 void stream_write_f(stream_t* stream, float value)
@@ -144,9 +138,9 @@ void stream_write_f(stream_t* stream, float value)
 
 void stream_write_vector3f(stream_t* stream, vector3f_t vector)
 {
-    stream_write_f(stream, vector.x);
-    stream_write_f(stream, vector.y);
-    stream_write_f(stream, vector.z);
+    ACCESS_CHECK_N(stream, 12);
+    stream_store_vector3f(stream->data + stream->pos, vector);
+    stream->pos += 12;
 }
 
 void stream_write_color_rgb(stream_t* stream, color_t color)
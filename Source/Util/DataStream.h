@@ -4,6 +4,7 @@
 
 #include <Util/Enums.h>
 #include <Util/Queue.h>
+#include <string.h>
 
 #define ACCESS_CHECK(stream, size)             \
     if (stream->pos + size > stream->length) { \
@@ -44,4 +45,117 @@ void     stream_write_color_3u8(stream_t* stream, uint8_t r, uint8_t g, uint8_t
 void     stream_write_color_4u8(stream_t* stream, uint8_t a, uint8_t r, uint8_t g, uint8_t b);
 void     stream_write_array(stream_t* stream, const void* array, uint32_t length);
 
+/**
+ * @brief Validate that `size` bytes are available and advance past them in one step
+ *
+ * Meant for fixed-layout packets: check the whole layout once, then decode or encode it with the unchecked
+ * stream_load_* / stream_store_* helpers at constant offsets of the returned pointer.
+ *
+ * @param stream Stream to take the bytes from
+ * @param size Number of bytes the layout needs
+ * @return Pointer to the first byte or NULL if the stream is too short (position is left untouched then)
+ */
+static inline uint8_t* stream_view(stream_t* stream, uint32_t size)
+{
+    if (stream->pos + size > stream->length) {
+        return NULL;
+    }
+    uint8_t* view = stream->data + stream->pos;
+    stream->pos += size;
+    return view;
+}
+
+// Unaligned little-endian loads and stores, memcpy compiles down to a single mov on every target we care about
+
+static inline uint8_t stream_load_u8(const uint8_t* data)
+{
+    return data[0];
+}
+
+static inline uint16_t stream_load_u16(const uint8_t* data)
+{
+    uint16_t value;
+    memcpy(&value, data, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap16(value);
+#endif
+    return value;
+}
+
+static inline uint32_t stream_load_u32(const uint8_t* data)
+{
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap32(value);
+#endif
+    return value;
+}
+
+static inline float stream_load_f(const uint8_t* data)
+{
+    uint32_t bits = stream_load_u32(data);
+    float    value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static inline vector3f_t stream_load_vector3f(const uint8_t* data)
+{
+    vector3f_t vector = {stream_load_f(data), stream_load_f(data + 4), stream_load_f(data + 8)};
+    return vector;
+}
+
+static inline color_t stream_load_color_rgb(const uint8_t* data)
+{
+    color_t color;
+    color.b = data[0];
+    color.g = data[1];
+    color.r = data[2];
+    color.a = 0x0;
+    return color;
+}
+
+static inline void stream_store_u8(uint8_t* data, uint8_t value)
+{
+    data[0] = value;
+}
+
+static inline void stream_store_u16(uint8_t* data, uint16_t value)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap16(value);
+#endif
+    memcpy(data, &value, sizeof(value));
+}
+
+static inline void stream_store_u32(uint8_t* data, uint32_t value)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap32(value);
+#endif
+    memcpy(data, &value, sizeof(value));
+}
+
+static inline void stream_store_f(uint8_t* data, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    stream_store_u32(data, bits);
+}
+
+static inline void stream_store_vector3f(uint8_t* data, vector3f_t vector)
+{
+    stream_store_f(data, vector.x);
+    stream_store_f(data + 4, vector.y);
+    stream_store_f(data + 8, vector.z);
+}
+
+static inline void stream_store_color_rgb(uint8_t* data, color_t color)
+{
+    data[0] = color.b;
+    data[1] = color.g;
+    data[2] = color.r;
+}
+
 #endif /* stream_H */
@@ -1,25 +1,22 @@
-#include <Server/Server.h>
-#include <Server/Structs/ServerStruct.h>
+#include <Util/Line.h>
 #include <Util/Types.h>
 #include <stdlib.h>
 
-#define TMAX_ALT_VALUE  (0x3FFFFFFF / 1024)
-#define MAX_LINE_LENGTH 50
+#define TMAX_ALT_VALUE (0x3FFFFFFF / 1024)
 
 /**
  * @brief Calculate block line
  *
  * @param v1 Start position
  * @param v2 End position
- * @param result Array of blocks positions
+ * @param size Map size, the line stops at the map border
+ * @param result Array of at least LINE_MAX_LENGTH blocks positions
  * @return Number of block positions
  */
-int line_get_blocks(const vector3i_t* v1, const vector3i_t* v2, vector3i_t* result)
+int line_get_blocks(const vector3i_t* v1, const vector3i_t* v2, vector3i_t size, vector3i_t* result)
 {
     int count = 0;
 
-    server_t* server = get_server();
-
     vector3i_t pos  = *v1;
     vector3i_t dist = {v2->x - v1->x, v2->y - v1->y, v2->z - v1->z};
     vector3i_t step;
@@ -56,25 +53,25 @@ int line_get_blocks(const vector3i_t* v1, const vector3i_t* v2, vector3i_t* resu
     while (1) {
         result[count++] = pos;
 
-        if (count >= MAX_LINE_LENGTH || (pos.x == v2->x && pos.y == v2->y && pos.z == v2->z)) { // reached limit or end
+        if (count >= LINE_MAX_LENGTH || (pos.x == v2->x && pos.y == v2->y && pos.z == v2->z)) { // reached limit or end
             break;
         }
 
         if (tmax.z <= tmax.x && tmax.z <= tmax.y) {
             pos.z += step.z;
-            if (pos.z >= server->s_map.map.size_z) {
+            if (pos.z < 0 || pos.z >= size.z) {
                 break;
             }
             tmax.z += delta.z;
         } else if (tmax.x < tmax.y) {
             pos.x += step.x;
-            if (pos.x >= server->s_map.map.size_x) {
+            if (pos.x < 0 || pos.x >= size.x) {
                 break;
             }
             tmax.x += delta.x;
         } else {
             pos.y += step.y;
-            if (pos.y >= server->s_map.map.size_y) {
+            if (pos.y < 0 || pos.y >= size.y) {
                 break;
             }
             tmax.y += delta.y;
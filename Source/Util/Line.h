@@ -10,14 +10,21 @@
 #define UTIL_LINE_H
 
 #include <Util/Types.h>
+
+// Longest block line a client may build
+#define LINE_MAX_LENGTH 50
+
 /**
  * @brief Calculate block line
  *
+ * Reentrant, only touches the arguments.
+ *
  * @param v1 Start position
  * @param v2 End position
- * @param result Array of blocks positions
+ * @param size Map size, the line stops at the map border
+ * @param result Array of at least LINE_MAX_LENGTH blocks positions
  * @return Number of block positions
  */
-int line_get_blocks(const vector3i_t* v1, const vector3i_t* v2, vector3i_t* result);
+int line_get_blocks(const vector3i_t* v1, const vector3i_t* v2, vector3i_t size, vector3i_t* result);
 
 #endif /* UTIL_LINE_H */
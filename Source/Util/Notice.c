@@ -1,3 +1,4 @@
+#include <Server/Egress.h>
 #include <Server/Structs/ServerStruct.h>
 #include <Util/Checks/PlayerChecks.h>
 #include <Util/Log.h>
@@ -5,7 +6,22 @@
 #include <stdarg.h>
 #include <stdio.h>
 
-void send_server_notice(player_t* player, uint8_t console, const char* message, ...)
+// OpenSpades expects a magic 0xFF byte in front of UTF-8 text
+static ENetPacket* _notice_packet(uint8_t player_id, const char* message, uint32_t length, uint8_t utf8)
+{
+    ENetPacket* packet = enet_packet_create(NULL, 3 + utf8 + length, ENET_PACKET_FLAG_RELIABLE);
+    stream_t    stream = {packet->data, packet->dataLength, 0};
+    stream_write_u8(&stream, PACKET_TYPE_CHAT_MESSAGE);
+    stream_write_u8(&stream, player_id);
+    stream_write_u8(&stream, 2);
+    if (utf8) {
+        stream_write_u8(&stream, 0xFF);
+    }
+    stream_write_array(&stream, message, length);
+    return packet;
+}
+
+void send_server_notice(server_t* server, player_t* player, uint8_t console, const char* message, ...)
 {
     va_list args;
     va_start(args, message);
@@ -18,20 +34,8 @@ void send_server_notice(player_t* player, uint8_t console, const char* message,
         return;
     }
 
-    uint8_t     utf8         = player->client == 'o';
-    uint32_t    fMessageSize = strlen(fMessage);
-    uint32_t    packetSize   = 3 + fMessageSize + utf8; // add 1 space for the magic byte
-    ENetPacket* packet       = enet_packet_create(NULL, packetSize, ENET_PACKET_FLAG_RELIABLE);
-    stream_t    stream       = {packet->data, packet->dataLength, 0};
-    stream_write_u8(&stream, PACKET_TYPE_CHAT_MESSAGE);
-    stream_write_u8(&stream, player->id);
-    stream_write_u8(&stream, 2);
-    if (utf8) {
-        stream_write_u8(&stream, 0xFF);
-    }
-
-    stream_write_array(&stream, fMessage, fMessageSize);
-    if (enet_peer_send(player->peer, 0, packet) != 0) {
+    ENetPacket* packet = _notice_packet(player->id, fMessage, strlen(fMessage), player->client == 'o');
+    if (egress_send(server, player, packet, EGRESS_CHAT) != 0) {
         enet_packet_destroy(packet);
     }
 }
@@ -44,48 +48,31 @@ void broadcast_server_notice(server_t* server, uint8_t console, const char* mess
     vsnprintf(fMessage, 1024, message, args);
     va_end(args);
 
-    uint32_t    fMessageSize = strlen(fMessage);
-    uint32_t    packetSize   = 3 + fMessageSize;
-    ENetPacket* packet       = enet_packet_create(NULL, packetSize, ENET_PACKET_FLAG_RELIABLE);
-    ENetPacket* packet_utf8  = enet_packet_create(NULL, packetSize + 1, ENET_PACKET_FLAG_RELIABLE);
-    stream_t    stream       = {packet->data, packet->dataLength, 0};
-    stream_t    stream_utf8  = {packet_utf8->data, packet_utf8->dataLength, 0};
-
-    stream_write_u8(&stream, PACKET_TYPE_CHAT_MESSAGE);
-    stream_write_u8(&stream, 33);
-    stream_write_u8(&stream, 2);
-    stream_write_array(&stream, fMessage, fMessageSize);
-
-    stream_write_u8(&stream_utf8, PACKET_TYPE_CHAT_MESSAGE);
-    stream_write_u8(&stream_utf8, 33);
-    stream_write_u8(&stream_utf8, 2);
-    stream_write_u8(&stream_utf8, 0xFF);
-    stream_write_array(&stream_utf8, fMessage, fMessageSize);
+    uint32_t fMessageSize = strlen(fMessage);
 
     if (console) {
         LOG_INFO("%s", fMessage);
     }
-    player_t *player, *tmp;
-    uint8_t   sent      = 0;
-    uint8_t   sent_utf8 = 0;
+
+    // Variants are only built once somebody needs them
+    ENetPacket* packets[2] = {NULL, NULL};
+    uint8_t     sent[2]    = {0, 0};
+    player_t *  player, *tmp;
     HASH_ITER(hh, server->players, player, tmp)
     {
         if (is_past_join_screen(player)) {
-            if (player->client == 'o') {
-                if (enet_peer_send(player->peer, 0, packet_utf8) == 0) {
-                    sent_utf8 = 1;
-                }
-            } else {
-                if (enet_peer_send(player->peer, 0, packet) == 0) {
-                    sent = 1;
-                }
+            uint8_t utf8 = player->client == 'o';
+            if (packets[utf8] == NULL) {
+                packets[utf8] = _notice_packet(33, fMessage, fMessageSize, utf8);
+            }
+            if (egress_send(server, player, packets[utf8], EGRESS_CHAT) == 0) {
+                sent[utf8] = 1;
             }
         }
     }
-    if (sent == 0) {
-        enet_packet_destroy(packet);
-    }
-    if (sent_utf8 == 0) {
-        enet_packet_destroy(packet_utf8);
+    for (uint8_t i = 0; i < 2; ++i) {
+        if (packets[i] != NULL && sent[i] == 0) {
+            enet_packet_destroy(packets[i]);
+        }
     }
 }
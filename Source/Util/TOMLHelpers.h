@@ -4,6 +4,13 @@
 #include <Util/Log.h>
 #include <tomlc99/toml.h>
 #include <Server/Structs/MapStruct.h>
+#include <stdlib.h>
+#include <string.h>
+
+// What to do when a required value is missing or malformed, after it has been logged
+#ifndef TOMLH_ON_ERROR
+    #define TOMLH_ON_ERROR exit(EXIT_FAILURE)
+#endif
 
 #define TOMLH_READ_FROM_FILE(toml, path)                                       \
     {                                                                          \
@@ -11,14 +18,14 @@
         FILE* toml##_fp = fopen(path, "r");                                    \
         if (!toml##_fp) {                                                      \
             LOG_ERROR("Cannot find TOML file %s", path);                       \
-            exit(EXIT_FAILURE);                                                \
+            TOMLH_ON_ERROR;                                                    \
         }                                                                      \
         toml = toml_parse_file(toml##_fp, toml##_error, sizeof(toml##_error)); \
         fclose(toml##_fp);                                                     \
         if (!toml) {                                                           \
             LOG_ERROR("Failed to read %s.", path);                             \
             LOG_ERROR("%s", toml##_error);                                     \
-            exit(EXIT_FAILURE);                                                \
+            TOMLH_ON_ERROR;                                                    \
         }                                                                      \
     }
 
@@ -27,7 +34,7 @@
         table = toml_table_in(toml, table_name);             \
         if (!table) {                                        \
             LOG_ERROR("Cannot find table [%s]", table_name); \
-            exit(EXIT_FAILURE);                              \
+            TOMLH_ON_ERROR;                                  \
         }                                                    \
     }
 
@@ -60,7 +67,7 @@
                 toml_datum_t out##_array_elm = toml_int_at(out##_array, i);                                  \
                 if (!out##_array_elm.ok) {                                                                   \
                     LOG_ERROR("Failed to read " #name "[%zu] from TOML", i);                                 \
-                    exit(EXIT_FAILURE);                                                                      \
+                    TOMLH_ON_ERROR;                                                                          \
                 }                                                                                            \
                 out[i] = (int) out##_array_elm.u.i;                                                          \
             } else {                                                                                         \
@@ -81,7 +88,7 @@
                 goto out##_done_reading;                                         \
             } else {                                                             \
                 LOG_ERROR("Failed to read string array '%s' from TOML", name);   \
-                exit(EXIT_FAILURE);                                              \
+                TOMLH_ON_ERROR;                                                  \
             }                                                                    \
         }                                                                        \
         size_out = toml_array_nelem(out##_array);                                \
@@ -89,7 +96,7 @@
             toml_datum_t out##_array_elm = toml_string_at(out##_array, i);       \
             if (!out##_array_elm.ok) {                                           \
                 LOG_ERROR("Failed to read " #name "[%zu] from TOML", i);         \
-                exit(EXIT_FAILURE);                                              \
+                TOMLH_ON_ERROR;                                                  \
             }                                                                    \
             string_node_t* out##_string = spadesx_malloc(sizeof(string_node_t)); \
             out##_string->string        = (char*) out##_array_elm.u.s;           \
@@ -98,8 +105,9 @@
     }                                                                            \
     out##_done_reading:
 
+// The result is always heap allocated, the fallback included, so it can be freed either way
 #define TOMLH_GET_STRING(table, out, name, fallback, optional) \
-    TOMLH_GET_VAR(string, table, out, name, out##_datum.u.s, fallback, optional);
+    TOMLH_GET_VAR(string, table, out, name, out##_datum.u.s, strdup(fallback), optional);
 
 #define TOMLH_GET_BOOL(table, out, name, fallback, optional) \
     TOMLH_GET_VAR(bool, table, out, name, (int) out##_datum.u.b, fallback, optional);